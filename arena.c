@@ -0,0 +1,149 @@
+/**
+ * @file arena.c
+ * @brief Implémentation de l’allocateur par régions (arène).
+ *
+ * Chaque bloc est alloué avec un seul `malloc()` (en-tête et données contigus) ;
+ * les allocations sont alignées sur `max_align_t`.
+ *
+ * @see arena.h
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include "./arena.h"
+
+/** @brief Alignement garanti de chaque allocation. */
+#define ARENA_ALIGN (_Alignof(max_align_t))
+
+/**
+ * @brief Arrondit une taille au multiple supérieur de `ARENA_ALIGN`.
+ */
+static size_t alignUp(size_t size) {
+    return (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+}
+
+/**
+ * @brief Alloue un nouveau bloc d’au moins `size` octets et le place en tête de l’arène.
+ */
+static ArenaChunk* pushChunk(Arena* a, size_t size) {
+    size_t header = alignUp(sizeof(ArenaChunk));
+    ArenaChunk* chunk = malloc(header + size);
+    if (chunk == NULL)
+        return NULL;
+
+    chunk->data = (unsigned char*)chunk + header;
+    chunk->size = size;
+    chunk->used = 0;
+    chunk->next = a->head;
+    a->head = chunk;
+    a->num_chunks++;
+    return chunk;
+}
+
+/**
+ * @brief Crée une arène vide.
+ */
+Arena* createArena(size_t chunk_size) {
+    Arena* a = malloc(sizeof(Arena));
+    if (a == NULL)
+        return NULL;
+
+    a->head = NULL;
+    a->chunk_size = chunk_size > 0 ? alignUp(chunk_size) : ARENA_DEFAULT_CHUNK_SIZE;
+    a->last = NULL;
+    a->num_chunks = 0;
+    return a;
+}
+
+/**
+ * @brief Alloue `size` octets alignés dans l’arène.
+ */
+void* arenaAlloc(Arena* a, size_t size) {
+    if (a == NULL)
+        return NULL;
+
+    size = alignUp(size > 0 ? size : 1);
+
+    // Grosse demande : bloc dédié, inséré derrière le bloc courant pour ne pas le gaspiller
+    if (size > a->chunk_size / 4) {
+        ArenaChunk* current = a->head;
+        ArenaChunk* chunk = pushChunk(a, size);
+        if (chunk == NULL)
+            return NULL;
+        chunk->used = size;
+        if (current != NULL) {
+            a->head = current;
+            chunk->next = current->next;
+            current->next = chunk;
+        }
+        a->last = NULL;
+        return chunk->data;
+    }
+
+    if (a->head == NULL || a->head->size - a->head->used < size) {
+        if (pushChunk(a, a->chunk_size) == NULL)
+            return NULL;
+    }
+
+    void* ptr = a->head->data + a->head->used;
+    a->head->used += size;
+    a->last = ptr;
+    return ptr;
+}
+
+/**
+ * @brief Agrandit une allocation de l’arène (sur place si c’est la dernière).
+ */
+void* arenaRealloc(Arena* a, void* old, size_t old_size, size_t new_size) {
+    if (a == NULL)
+        return NULL;
+    if (old == NULL)
+        return arenaAlloc(a, new_size);
+    if (new_size <= old_size)
+        return old;
+
+    ArenaChunk* head = a->head;
+    if (old == a->last && head != NULL) {
+        size_t start = (size_t)((unsigned char*)old - head->data);
+        size_t needed = alignUp(new_size);
+        if (start + needed <= head->size) {
+            head->used = start + needed;
+            return old;
+        }
+    }
+
+    void* ptr = arenaAlloc(a, new_size);
+    if (ptr == NULL)
+        return NULL;
+    memcpy(ptr, old, old_size);
+    return ptr;
+}
+
+/**
+ * @brief Copie une chaîne de `len` caractères dans l’arène.
+ */
+char* arenaStrndup(Arena* a, const char* str, size_t len) {
+    char* copy = arenaAlloc(a, len + 1);
+    if (copy == NULL)
+        return NULL;
+    memcpy(copy, str, len);
+    copy[len] = '\0';
+    return copy;
+}
+
+/**
+ * @brief Libère tous les blocs de l’arène puis l’arène elle-même.
+ */
+void destroyArena(Arena* a) {
+    if (a == NULL)
+        return;
+
+    ArenaChunk* chunk = a->head;
+    while (chunk != NULL) {
+        ArenaChunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    free(a);
+}
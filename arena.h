@@ -0,0 +1,94 @@
+/**
+ * @file arena.h
+ * @brief Allocateur par régions (arène) utilisé pour les promotions chargées en bloc.
+ *
+ * Une arène découpe de grands blocs mémoire (`ArenaChunk`) en petites allocations
+ * successives. Les allocations ne sont jamais libérées individuellement : toute la
+ * mémoire est rendue en une fois par `destroyArena()`, ce qui remplace les centaines
+ * de milliers d’appels à `malloc()`/`free()` d’une promotion par quelques appels.
+ *
+ * @see struct_functions.h
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+/** @brief Taille par défaut d’un bloc de l’arène (1 Mio). */
+#define ARENA_DEFAULT_CHUNK_SIZE (1024 * 1024)
+
+/**
+ * @struct ArenaChunk
+ * @brief Bloc mémoire d’une arène, chaîné au bloc précédent.
+ */
+typedef struct ArenaChunk {
+    struct ArenaChunk* next;  /**< Bloc alloué précédemment (liste chaînée). */
+    size_t size;              /**< Taille utilisable du bloc en octets. */
+    size_t used;              /**< Nombre d’octets déjà distribués. */
+    unsigned char* data;      /**< Début de la zone utilisable (suit l’en-tête). */
+} ArenaChunk;
+
+/**
+ * @struct Arena
+ * @brief Arène mémoire : liste de blocs dont seul le plus récent reçoit les allocations.
+ */
+typedef struct Arena {
+    ArenaChunk* head;         /**< Bloc courant. */
+    size_t chunk_size;        /**< Taille des nouveaux blocs. */
+    void* last;               /**< Dernière allocation (peut être agrandie sur place). */
+    int num_chunks;           /**< Nombre de blocs alloués (statistique). */
+} Arena;
+
+/**
+ * @brief Crée une arène vide.
+ *
+ * @param chunk_size Taille des blocs à allouer (0 pour `ARENA_DEFAULT_CHUNK_SIZE`).
+ * @return Pointeur vers l’arène, ou NULL en cas d’échec.
+ */
+Arena* createArena(size_t chunk_size);
+
+/**
+ * @brief Alloue `size` octets alignés dans l’arène.
+ *
+ * Les demandes plus grandes qu’un quart de bloc reçoivent leur propre bloc.
+ *
+ * @param a    Pointeur vers l’arène.
+ * @param size Nombre d’octets demandés.
+ * @return Pointeur vers la zone allouée (non initialisée), ou NULL en cas d’échec.
+ */
+void* arenaAlloc(Arena* a, size_t size);
+
+/**
+ * @brief Agrandit une allocation de l’arène.
+ *
+ * Si `old` est la dernière allocation et que le bloc courant a la place, elle est
+ * agrandie sur place ; sinon une nouvelle zone est allouée et le contenu copié
+ * (l’ancienne zone reste perdue jusqu’à la destruction de l’arène).
+ *
+ * @param a        Pointeur vers l’arène.
+ * @param old      Allocation à agrandir (NULL pour une nouvelle allocation).
+ * @param old_size Taille actuelle de `old` en octets.
+ * @param new_size Nouvelle taille en octets.
+ * @return Pointeur vers la zone agrandie, ou NULL en cas d’échec.
+ */
+void* arenaRealloc(Arena* a, void* old, size_t old_size, size_t new_size);
+
+/**
+ * @brief Copie une chaîne de `len` caractères dans l’arène et la termine par `'\0'`.
+ *
+ * @param a   Pointeur vers l’arène.
+ * @param str Chaîne source (n’a pas besoin d’être terminée par `'\0'`).
+ * @param len Nombre de caractères à copier.
+ * @return Copie de la chaîne, ou NULL en cas d’échec.
+ */
+char* arenaStrndup(Arena* a, const char* str, size_t len);
+
+/**
+ * @brief Libère tous les blocs de l’arène puis l’arène elle-même.
+ *
+ * @param a Pointeur vers l’arène à détruire.
+ */
+void destroyArena(Arena* a);
+
+#endif // ARENA_H
@@ -0,0 +1,274 @@
+/**
+ * @file campus.c
+ * @brief Chargement parallèle de plusieurs promotions et fusion de leurs classements.
+ *
+ * @see campus.h
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "./campus.h"
+#include "./file_gestion.h"
+#include "./file_sorting.h"
+#include "./struct_functions.h"
+#include "./parallel.h"
+
+/**
+ * @struct CampusLoad
+ * @brief File des fichiers à charger, partagée par les threads.
+ */
+typedef struct CampusLoad {
+    char** filenames;
+    Prom** promos;
+    int num_files;
+    int flags;
+    int next;                      /**< Prochain fichier à charger. */
+    pthread_mutex_t lock;          /**< Protège `next`. */
+} CampusLoad;
+
+/**
+ * @brief Charge des fichiers de la file jusqu’à ce qu’elle soit vide.
+ */
+static void* loadCampusWorker(void* arg) {
+    CampusLoad* load = arg;
+
+    for (;;) {
+        pthread_mutex_lock(&load->lock);
+        int i = load->next++;
+        pthread_mutex_unlock(&load->lock);
+        if (i >= load->num_files)
+            return NULL;
+        load->promos[i] = loadPromotionFromFileEx(load->filenames[i], load->flags);
+    }
+}
+
+/**
+ * @brief Charge plusieurs fichiers texte en parallèle, chacun dans sa propre promotion.
+ */
+Campus* loadCampus(char** filenames, int num_files, int flags, int num_threads) {
+    if (filenames == NULL || num_files <= 0)
+        return NULL;
+
+    Campus* c = malloc(sizeof(Campus));
+    if (c == NULL)
+        return NULL;
+    c->num_promos = num_files;
+    c->promos = calloc(num_files, sizeof(Prom*));
+    if (c->promos == NULL) {
+        free(c);
+        return NULL;
+    }
+
+    CampusLoad load = { filenames, c->promos, num_files, flags, 0, PTHREAD_MUTEX_INITIALIZER };
+    int nb_threads = parallelThreadCount(num_threads, (size_t)num_files, (size_t)num_files);
+
+    // Tous les threads partagent la file : un thread qui ne démarre pas laisse ses fichiers aux autres
+    runParallel(&load, 0, nb_threads, loadCampusWorker);
+    pthread_mutex_destroy(&load.lock);
+
+    for (int i = 0; i < num_files; i++) {
+        if (c->promos[i] == NULL) {
+            fprintf(stderr, "Erreur : chargement de la promotion %s impossible.\n", filenames[i]);
+            destroyCampus(c);
+            return NULL;
+        }
+    }
+    return c;
+}
+
+/**
+ * @brief Libère un campus et toutes ses promotions.
+ */
+void destroyCampus(Campus* c) {
+    if (c == NULL)
+        return;
+    for (int i = 0; i < c->num_promos; i++)
+        destroyProm(c->promos[i]);
+    free(c->promos);
+    free(c);
+}
+
+/**
+ * @struct CampusLists
+ * @brief Les `k` premiers de chaque promotion, bout à bout, et le tas qui les fusionne.
+ */
+typedef struct CampusLists {
+    CampusEntry* entries;          /**< Listes triées, celle de la promotion `i` à partir de `starts[i]`. */
+    int* starts;                   /**< Début de chaque liste, `num_promos + 1` entrées. */
+    int* cursors;                  /**< Prochaine entrée de chaque liste. */
+    int* heap;                     /**< Tas des promotions dont la liste n’est pas épuisée. */
+} CampusLists;
+
+/**
+ * @brief Alloue les listes, au plus `k` entrées par promotion.
+ *
+ * Les listes doivent être libérées avec `freeCampusLists()`, même en cas d’échec.
+ * @return 0 si succès, -1 en cas d’erreur d’allocation.
+ */
+static int createCampusLists(CampusLists* lists, const Campus* c, int k) {
+    lists->starts = malloc(sizeof(int) * (c->num_promos + 1));
+    lists->cursors = malloc(sizeof(int) * (c->num_promos > 0 ? c->num_promos : 1));
+    lists->heap = malloc(sizeof(int) * (c->num_promos > 0 ? c->num_promos : 1));
+    lists->entries = NULL;
+    if (lists->starts == NULL || lists->cursors == NULL || lists->heap == NULL)
+        return -1;
+
+    size_t total = 0;
+    for (int i = 0; i < c->num_promos; i++) {
+        int n = c->promos[i]->num_students;
+        total += (size_t)(n < k ? n : k);
+    }
+    lists->entries = malloc(sizeof(CampusEntry) * (total > 0 ? total : 1));
+    return lists->entries != NULL ? 0 : -1;
+}
+
+/**
+ * @brief Libère les listes.
+ */
+static void freeCampusLists(CampusLists* lists) {
+    free(lists->entries);
+    free(lists->starts);
+    free(lists->cursors);
+    free(lists->heap);
+}
+
+/**
+ * @brief Moyenne qui classe une entrée : générale, ou dans la matière de l’inscription.
+ */
+static float entryAverage(const CampusEntry* e) {
+    return e->enrollment < 0 ? e->student->general_average
+                             : e->student->courses[e->enrollment].average;
+}
+
+/**
+ * @brief Vrai si la tête de liste de la promotion `a` passe avant celle de `b`.
+ */
+static int headBefore(const CampusLists* lists, int a, int b) {
+    float avg_a = entryAverage(&lists->entries[lists->cursors[a]]);
+    float avg_b = entryAverage(&lists->entries[lists->cursors[b]]);
+    if (avg_a != avg_b)
+        return avg_a > avg_b;
+    return a < b;
+}
+
+/**
+ * @brief Rétablit le tas à partir de l’indice `i`, en descendant.
+ */
+static void siftDownHeads(const CampusLists* lists, int size, int i) {
+    int* heap = lists->heap;
+    for (;;) {
+        int best = i;
+        int left = 2 * i + 1, right = left + 1;
+        if (left < size && headBefore(lists, heap[left], heap[best]))
+            best = left;
+        if (right < size && headBefore(lists, heap[right], heap[best]))
+            best = right;
+        if (best == i)
+            return;
+        int tmp = heap[i];
+        heap[i] = heap[best];
+        heap[best] = tmp;
+        i = best;
+    }
+}
+
+/**
+ * @brief Fusion des listes triées : copie les `k` meilleures têtes successives dans `out`.
+ * @return Le nombre d’entrées copiées.
+ */
+static int mergeCampusLists(CampusLists* lists, int num_promos, int k, CampusEntry* out) {
+    int size = 0;
+    for (int i = 0; i < num_promos; i++) {
+        lists->cursors[i] = lists->starts[i];
+        if (lists->starts[i] < lists->starts[i + 1])
+            lists->heap[size++] = i;
+    }
+    for (int i = size / 2 - 1; i >= 0; i--)
+        siftDownHeads(lists, size, i);
+
+    int n = 0;
+    while (n < k && size > 0) {
+        int p = lists->heap[0];
+        out[n++] = lists->entries[lists->cursors[p]++];
+        if (lists->cursors[p] == lists->starts[p + 1])
+            lists->heap[0] = lists->heap[--size];
+        siftDownHeads(lists, size, 0);
+    }
+    return n;
+}
+
+/**
+ * @brief Sélectionne les `k` meilleurs étudiants du campus, triés par moyenne générale décroissante.
+ */
+int getCampusTopKStudents(const Campus* c, int k, CampusEntry* out, int* count) {
+    if (count != NULL)
+        *count = 0;
+    if (c == NULL || out == NULL || count == NULL || k < 0)
+        return -1;
+    if (k == 0)
+        return 0;
+
+    CampusLists lists;
+    int status = createCampusLists(&lists, c, k);
+    Student** top = malloc(sizeof(Student*) * k);
+    if (status == -1 || top == NULL) {
+        free(top);
+        freeCampusLists(&lists);
+        return -1;
+    }
+
+    int next = 0;
+    for (int i = 0; i < c->num_promos; i++) {
+        int n = 0;
+        lists.starts[i] = next;
+        getTopKStudents(c->promos[i], k, top, &n);
+        for (int j = 0; j < n; j++)
+            lists.entries[next++] = (CampusEntry){ top[j], i, -1 };
+    }
+    lists.starts[c->num_promos] = next;
+
+    *count = mergeCampusLists(&lists, c->num_promos, k, out);
+    freeCampusLists(&lists);
+    free(top);
+    return 0;
+}
+
+/**
+ * @brief Sélectionne les `k` meilleurs inscrits d’une matière sur tout le campus.
+ */
+int getCampusTopKStudentsCourse(const Campus* c, const char* course_name, int k, CampusEntry* out, int* count) {
+    if (count != NULL)
+        *count = 0;
+    if (c == NULL || course_name == NULL || out == NULL || count == NULL || k < 0)
+        return -1;
+
+    CampusLists lists;
+    int status = createCampusLists(&lists, c, k);
+    RosterEntry* top = malloc(sizeof(RosterEntry) * (k > 0 ? k : 1));
+    if (status == -1 || top == NULL) {
+        free(top);
+        freeCampusLists(&lists);
+        return -1;
+    }
+
+    int next = 0, found = 0;
+    for (int i = 0; i < c->num_promos; i++) {
+        int n = 0;
+        lists.starts[i] = next;
+        if (getTopKStudentsCourse(c->promos[i], course_name, k, top, &n) == -1)
+            continue;   // matière absente du catalogue de cette promotion
+        found = 1;
+        for (int j = 0; j < n; j++)
+            lists.entries[next++] = (CampusEntry){ top[j].student, i, top[j].enrollment };
+    }
+    lists.starts[c->num_promos] = next;
+
+    if (found)
+        *count = mergeCampusLists(&lists, c->num_promos, k, out);
+    freeCampusLists(&lists);
+    free(top);
+    return found ? 0 : -1;
+}
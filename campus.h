@@ -0,0 +1,93 @@
+/**
+ * @file campus.h
+ * @brief Ensemble de promotions chargées en parallèle, et classements à l’échelle du campus.
+ *
+ * `loadCampus()` charge plusieurs fichiers texte, chacun dans sa propre `Prom`, avec
+ * un ensemble de threads qui se partagent les fichiers : chaque thread prend le
+ * fichier suivant dès qu’il a fini le précédent, si bien qu’une grosse promotion
+ * n’immobilise qu’un seul thread.
+ *
+ * Les requêtes du campus ne regroupent ni ne retrient les étudiants de toutes les
+ * promotions : elles demandent les `k` premiers de chaque promotion
+ * (`getTopKStudents()`, `getTopKStudentsCourse()`, en O(k) avec les classements de
+ * `enableLeaderboards()`), puis fusionnent ces listes déjà triées avec un tas d’une
+ * entrée par promotion, en O(k log P) pour P promotions. À moyenne égale, la
+ * promotion chargée en premier passe en premier, puis l’ordre de la promotion.
+ *
+ * @see file_sorting.h
+ */
+
+#ifndef CAMPUS_H
+#define CAMPUS_H
+
+#include "./struct.h"
+
+/**
+ * @struct Campus
+ * @brief Promotions chargées ensemble, dans l’ordre des fichiers.
+ */
+typedef struct Campus {
+    Prom** promos;          /**< Promotions, une par fichier. */
+    int num_promos;         /**< Nombre de promotions. */
+} Campus;
+
+/**
+ * @struct CampusEntry
+ * @brief Étudiant classé à l’échelle du campus.
+ */
+typedef struct CampusEntry {
+    Student* student;       /**< L’étudiant. */
+    int promo_index;        /**< Indice de sa promotion dans `Campus.promos`. */
+    int enrollment;         /**< Indice de son inscription à la matière (-1 pour le classement général). */
+} CampusEntry;
+
+/**
+ * @brief Charge plusieurs fichiers texte en parallèle, chacun dans sa propre promotion.
+ *
+ * Chaque fichier est chargé par `loadPromotionFromFileEx()` avec les mêmes options ;
+ * le résultat est identique à des chargements successifs.
+ *
+ * @param filenames   Chemins des fichiers.
+ * @param num_files   Nombre de fichiers.
+ * @param flags       Options de chargement (`LOAD_*`, voir `file_gestion.h`).
+ * @param num_threads Nombre de threads (0 : un par cœur disponible, au plus un par fichier).
+ * @return Le campus, ou NULL si un fichier ne peut pas être chargé ou en cas d’erreur d’allocation.
+ *
+ * @note Le campus doit être libéré avec `destroyCampus()`.
+ */
+Campus* loadCampus(char** filenames, int num_files, int flags, int num_threads);
+
+/**
+ * @brief Libère un campus et toutes ses promotions.
+ *
+ * @param c Campus à libérer (peut être NULL).
+ */
+void destroyCampus(Campus* c);
+
+/**
+ * @brief Sélectionne les `k` meilleurs étudiants du campus, triés par moyenne générale décroissante.
+ *
+ * @param c     Pointeur vers le campus.
+ * @param k     Nombre d’étudiants demandés.
+ * @param out   Tableau d’au moins `k` entrées, rempli avec les étudiants classés.
+ * @param count Pointeur vers un entier où sera stocké le nombre d’étudiants retournés (≤ k).
+ * @return 0 si succès, -1 si un argument est invalide ou en cas d’erreur d’allocation.
+ */
+int getCampusTopKStudents(const Campus* c, int k, CampusEntry* out, int* count);
+
+/**
+ * @brief Sélectionne les `k` meilleurs inscrits d’une matière sur tout le campus, triés par moyenne décroissante.
+ *
+ * Les promotions dont le catalogue ne contient pas la matière sont ignorées.
+ *
+ * @param c           Pointeur vers le campus.
+ * @param course_name Nom de la matière.
+ * @param k           Nombre d’étudiants demandés.
+ * @param out         Tableau d’au moins `k` entrées, rempli avec les inscrits classés.
+ * @param count       Pointeur vers un entier où sera stocké le nombre d’inscrits retournés (≤ k).
+ * @return 0 si succès, -1 si un argument est invalide, si aucune promotion n’a la
+ *         matière ou en cas d’erreur d’allocation.
+ */
+int getCampusTopKStudentsCourse(const Campus* c, const char* course_name, int k, CampusEntry* out, int* count);
+
+#endif // CAMPUS_H
@@ -0,0 +1,279 @@
+/**
+ * @file course_stats.c
+ * @brief Agrégats par thread, fusion et sélection rapide des statistiques de chaque matière.
+ *
+ * @see course_stats.h
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "./course_stats.h"
+#include "./parallel.h"
+
+/** @brief Nombre minimal d’étudiants par thread en mode automatique. */
+#define STATS_MIN_STUDENTS 4096
+
+/**
+ * @struct StatsPartial
+ * @brief Agrégats d’une matière sur un bloc d’étudiants.
+ */
+typedef struct StatsPartial {
+    int count;                     /**< Nombre de moyennes. */
+    double mean;                   /**< Moyenne courante. */
+    double m2;                     /**< Somme des carrés des écarts à la moyenne. */
+    float min;                     /**< Plus petite moyenne. */
+    float max;                     /**< Plus grande moyenne. */
+    int histogram[STATS_BUCKETS];  /**< Histogramme par demi-point. */
+} StatsPartial;
+
+/**
+ * @struct StatsChunk
+ * @brief Travail d’un thread : un bloc d’étudiants, puis une partie des matières.
+ */
+typedef struct StatsChunk {
+    const Prom* promo;
+    StatsPartial* partials;        /**< Phase 1 : un agrégat par matière. */
+    int first_student;             /**< Phase 1 : premier étudiant du bloc. */
+    int last_student;              /**< Phase 1 : étudiant suivant le dernier du bloc. */
+    int thread_index;              /**< Phase 2 : matières `thread_index`, `thread_index + nb_chunks`… */
+    int nb_chunks;                 /**< Phase 2 : pas de la répartition des matières. */
+    float* scratch;                /**< Phase 2 : moyennes de la matière en cours de sélection. */
+    CourseStats* stats;            /**< Résultat, une entrée par matière. */
+} StatsChunk;
+
+/**
+ * @brief Tranche de l’histogramme d’une moyenne.
+ */
+static int bucketOf(float average) {
+    int b = (int)(average * 2.0f);
+    if (b < 0)
+        return 0;
+    return b < STATS_BUCKETS ? b : STATS_BUCKETS - 1;
+}
+
+/**
+ * @brief Ajoute une moyenne aux agrégats (méthode de Welford).
+ */
+static void addToPartial(StatsPartial* part, float average) {
+    if (part->count == 0 || average < part->min)
+        part->min = average;
+    if (part->count == 0 || average > part->max)
+        part->max = average;
+
+    part->count++;
+    double delta = average - part->mean;
+    part->mean += delta / part->count;
+    part->m2 += delta * (average - part->mean);
+    part->histogram[bucketOf(average)]++;
+}
+
+/**
+ * @brief Fusionne les agrégats `from` dans `into` (formule de Chan et al.).
+ */
+static void mergePartial(StatsPartial* into, const StatsPartial* from) {
+    if (from->count == 0)
+        return;
+    if (into->count == 0) {
+        *into = *from;
+        return;
+    }
+
+    int count = into->count + from->count;
+    double delta = from->mean - into->mean;
+    into->mean += delta * from->count / count;
+    into->m2 += from->m2 + delta * delta * ((double)into->count * from->count / count);
+    into->count = count;
+    if (from->min < into->min)
+        into->min = from->min;
+    if (from->max > into->max)
+        into->max = from->max;
+    for (int b = 0; b < STATS_BUCKETS; b++)
+        into->histogram[b] += from->histogram[b];
+}
+
+/**
+ * @brief Phase 1 : agrégats des moyennes des étudiants d’un bloc, matière par matière.
+ */
+static void* aggregateStatsChunk(void* arg) {
+    StatsChunk* chunk = arg;
+    const Prom* promo = chunk->promo;
+
+    for (int i = chunk->first_student; i < chunk->last_student; i++) {
+        const Student* s = promo->students[i];
+        for (int j = 0; j < s->num_courses; j++) {
+            const Enrollment* e = &s->courses[j];
+            if (e->grades.size > 0)
+                addToPartial(&chunk->partials[e->course_index], e->average);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Échange deux moyennes.
+ */
+static void swapFloats(float* a, float* b) {
+    float tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+/**
+ * @brief Place la `k`-ième plus petite valeur à l’indice `k` (sélection rapide).
+ *
+ * Partition en trois zones (inférieures, égales, supérieures au pivot) : les
+ * nombreuses moyennes égales ne dégradent pas la sélection. Après l’appel, les
+ * valeurs d’indice supérieur à `k` lui sont toutes supérieures ou égales.
+ */
+static float selectKth(float* values, int n, int k) {
+    int lo = 0, hi = n - 1;
+    while (lo < hi) {
+        // Pivot : médiane du premier, du milieu et du dernier
+        float a = values[lo], b = values[lo + (hi - lo) / 2], c = values[hi];
+        float pivot = (a < b) ? ((b < c) ? b : (a < c ? c : a)) : ((a < c) ? a : (b < c ? c : b));
+
+        int lt = lo, i = lo, gt = hi;
+        while (i <= gt) {
+            if (values[i] < pivot)
+                swapFloats(&values[lt++], &values[i++]);
+            else if (values[i] > pivot)
+                swapFloats(&values[i], &values[gt--]);
+            else
+                i++;
+        }
+
+        if (k < lt)
+            hi = lt - 1;
+        else if (k > gt)
+            lo = gt + 1;
+        else
+            return pivot;
+    }
+    return values[k];
+}
+
+/**
+ * @brief Quantile `q` par interpolation linéaire entre les deux valeurs encadrantes.
+ */
+static float quantile(float* values, int n, double q) {
+    double rank = q * (n - 1);
+    int k = (int)rank;
+    float low = selectKth(values, n, k);
+    if (k + 1 >= n || rank == k)
+        return low;
+
+    // La valeur suivante est la plus petite de celles placées après `k`
+    float high = values[k + 1];
+    for (int i = k + 2; i < n; i++)
+        if (values[i] < high)
+            high = values[i];
+    return (float)(low + (rank - k) * (high - low));
+}
+
+/**
+ * @brief Phase 2 : médiane et quartiles des matières attribuées au thread.
+ */
+static void* quantileStatsChunk(void* arg) {
+    StatsChunk* chunk = arg;
+    const Prom* promo = chunk->promo;
+
+    for (int c = chunk->thread_index; c < promo->num_courses; c += chunk->nb_chunks) {
+        const CourseRoster* roster = &promo->rosters[c];
+        int n = 0;
+        for (int i = 0; i < roster->size; i++) {
+            const Enrollment* e = &roster->entries[i].student->courses[roster->entries[i].enrollment];
+            if (e->grades.size > 0)
+                chunk->scratch[n++] = e->average;
+        }
+        if (n == 0)
+            continue;
+
+        CourseStats* st = &chunk->stats[c];
+        st->median = quantile(chunk->scratch, n, 0.5);
+        st->q1 = quantile(chunk->scratch, n, 0.25);
+        st->q3 = quantile(chunk->scratch, n, 0.75);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Libère les tampons des morceaux.
+ */
+static void freeStatsChunks(StatsChunk* chunks, int nb_chunks) {
+    for (int k = 0; k < nb_chunks; k++) {
+        free(chunks[k].partials);
+        free(chunks[k].scratch);
+    }
+}
+
+/**
+ * @brief Calcule les statistiques de toutes les matières d’une promotion.
+ */
+CourseStats* computeCourseStats(const Prom* p, int num_threads) {
+    if (p == NULL)
+        return NULL;
+
+    int nb_courses = p->num_courses;
+    CourseStats* stats = calloc(nb_courses > 0 ? nb_courses : 1, sizeof(CourseStats));
+    if (stats == NULL)
+        return NULL;
+    if (nb_courses == 0)
+        return stats;
+
+    int max_roster = 0;
+    for (int c = 0; c < nb_courses; c++)
+        if (p->rosters[c].size > max_roster)
+            max_roster = p->rosters[c].size;
+
+    int nb_chunks = parallelThreadCount(num_threads, p->num_students / STATS_MIN_STUDENTS, p->num_students);
+    StatsChunk chunks[PARALLEL_MAX_THREADS];
+    memset(chunks, 0, sizeof(chunks));
+
+    int failed = 0;
+    for (int k = 0; k < nb_chunks; k++) {
+        StatsChunk* chunk = &chunks[k];
+        chunk->promo = p;
+        chunk->stats = stats;
+        chunk->first_student = (int)((long long)p->num_students * k / nb_chunks);
+        chunk->last_student = (int)((long long)p->num_students * (k + 1) / nb_chunks);
+        chunk->thread_index = k;
+        chunk->nb_chunks = nb_chunks;
+        chunk->partials = calloc(nb_courses, sizeof(StatsPartial));
+        chunk->scratch = malloc(sizeof(float) * (max_roster > 0 ? max_roster : 1));
+        if (chunk->partials == NULL || chunk->scratch == NULL)
+            failed = 1;
+    }
+    if (failed) {
+        freeStatsChunks(chunks, nb_chunks);
+        free(stats);
+        return NULL;
+    }
+
+    runParallel(chunks, sizeof(StatsChunk), nb_chunks, aggregateStatsChunk);
+
+    // Fusion dans l’ordre des blocs, puis moments et histogrammes de chaque matière
+    for (int k = 1; k < nb_chunks; k++)
+        for (int c = 0; c < nb_courses; c++)
+            mergePartial(&chunks[0].partials[c], &chunks[k].partials[c]);
+
+    for (int c = 0; c < nb_courses; c++) {
+        const StatsPartial* part = &chunks[0].partials[c];
+        CourseStats* st = &stats[c];
+        st->count = part->count;
+        if (part->count == 0)
+            continue;
+        st->mean = (float)part->mean;
+        st->stddev = (float)sqrt(part->m2 / part->count);
+        st->min = part->min;
+        st->max = part->max;
+        memcpy(st->histogram, part->histogram, sizeof(st->histogram));
+    }
+
+    runParallel(chunks, sizeof(StatsChunk), nb_chunks, quantileStatsChunk);
+
+    freeStatsChunks(chunks, nb_chunks);
+    return stats;
+}
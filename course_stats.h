@@ -0,0 +1,65 @@
+/**
+ * @file course_stats.h
+ * @brief Statistiques de chaque matière d’une promotion, calculées en parallèle.
+ *
+ * Pour chaque matière du catalogue, les statistiques portent sur les moyennes des
+ * étudiants inscrits qui ont au moins une note dans la matière : effectif, moyenne,
+ * écart type, minimum, maximum, médiane, quartiles et histogramme par tranches
+ * d’un demi-point.
+ *
+ * Le calcul se fait en deux phases :
+ * - un seul passage sur les étudiants, découpés en blocs contigus, un par thread :
+ *   chaque thread tient ses propres agrégats par matière (effectif, moyenne et
+ *   somme des carrés des écarts selon Welford, extrêmes, histogramme), fusionnés
+ *   à la fin dans l’ordre des blocs ;
+ * - la médiane et les quartiles, par sélection rapide (« quickselect ») sur les
+ *   moyennes des inscrits de chaque matière (`Prom.rosters`), les matières étant
+ *   réparties entre les threads.
+ *
+ * Effectifs, extrêmes, histogrammes et quantiles ne dépendent pas du nombre de
+ * threads ; moyenne et écart type peuvent en dépendre au dernier bit près.
+ *
+ * @see struct.h
+ */
+
+#ifndef COURSE_STATS_H
+#define COURSE_STATS_H
+
+#include "./struct.h"
+
+/** @brief Nombre de tranches de l’histogramme : de 0 à 20 par demi-point (20 compte dans la dernière). */
+#define STATS_BUCKETS 40
+
+/**
+ * @struct CourseStats
+ * @brief Statistiques des moyennes des inscrits d’une matière.
+ *
+ * Une matière sans inscrit noté a un effectif nul et toutes ses valeurs à 0.
+ */
+typedef struct CourseStats {
+    int count;                     /**< Nombre d’inscrits ayant au moins une note. */
+    float mean;                    /**< Moyenne des moyennes des inscrits. */
+    float stddev;                  /**< Écart type (de population, divisé par l’effectif). */
+    float min;                     /**< Plus petite moyenne. */
+    float max;                     /**< Plus grande moyenne. */
+    float q1;                      /**< Premier quartile. */
+    float median;                  /**< Médiane. */
+    float q3;                      /**< Troisième quartile. */
+    int histogram[STATS_BUCKETS];  /**< `histogram[b]` : moyennes dans [b / 2, b / 2 + 0,5[. */
+} CourseStats;
+
+/**
+ * @brief Calcule les statistiques de toutes les matières d’une promotion.
+ *
+ * Les quantiles sont interpolés linéairement entre les deux valeurs encadrantes :
+ * le quantile `q` vaut la valeur de rang `q × (n - 1)` dans la liste triée.
+ *
+ * @param p           Pointeur vers la promotion.
+ * @param num_threads Nombre de threads (0 : un par cœur disponible, selon la taille de la promotion).
+ * @return Un tableau de `p->num_courses` statistiques, dans l’ordre du catalogue, ou NULL en cas d’erreur.
+ *
+ * @note Le tableau retourné doit être libéré avec `free()` par l’appelant.
+ */
+CourseStats* computeCourseStats(const Prom* p, int num_threads);
+
+#endif // COURSE_STATS_H
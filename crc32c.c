@@ -0,0 +1,220 @@
+/**
+ * @file crc32c.c
+ * @brief Calcul du CRC32C, accéléré par SSE4.2 ou en slice-by-8.
+ *
+ * @see crc32c.h
+ */
+
+#include <string.h>
+#include <pthread.h>
+#include "./crc32c.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <nmmintrin.h>
+#define CRC32C_HAVE_SSE42 1
+#endif
+
+/** @brief Polynôme de Castagnoli, forme réfléchie. */
+#define CRC32C_POLY 0x82F63B78u
+
+/** @brief Tables du slice-by-8 : `table[k][b]` est le CRC de l’octet `b` suivi de `k` octets nuls. */
+static uint32_t crc_table[8][256];
+
+/** @brief Initialisation unique des tables et du choix de la version. */
+static pthread_once_t crc_once = PTHREAD_ONCE_INIT;
+
+/** @brief Vaut 1 si l’instruction `crc32` de SSE4.2 est disponible. */
+static int use_hardware = 0;
+
+/** @brief Longueur des trois flux entrelacés pour les grandes zones. */
+#define CRC32C_LONG 8192
+/** @brief Longueur des trois flux entrelacés pour les zones moyennes. */
+#define CRC32C_SHORT 256
+
+/** @brief Tables décalant un CRC de `CRC32C_LONG` octets nuls. */
+static uint32_t crc_long[4][256];
+/** @brief Tables décalant un CRC de `CRC32C_SHORT` octets nuls. */
+static uint32_t crc_short[4][256];
+
+/**
+ * @brief Multiplie un vecteur par une matrice sur GF(2) (32 colonnes).
+ */
+static uint32_t gf2MatrixTimes(const uint32_t* mat, uint32_t vec) {
+    uint32_t sum = 0;
+    while (vec) {
+        if (vec & 1)
+            sum ^= *mat;
+        vec >>= 1;
+        mat++;
+    }
+    return sum;
+}
+
+/**
+ * @brief Élève une matrice sur GF(2) au carré.
+ */
+static void gf2MatrixSquare(uint32_t* square, const uint32_t* mat) {
+    for (int n = 0; n < 32; n++)
+        square[n] = gf2MatrixTimes(mat, mat[n]);
+}
+
+/**
+ * @brief Construit les tables qui appliquent `len` octets nuls à un CRC (`len` puissance de 2).
+ *
+ * Permet de recoller les CRC de blocs calculés indépendamment : le CRC de A suivi
+ * de B vaut le CRC de A décalé de |B| octets, combiné par ou exclusif au CRC de B.
+ */
+static void buildShiftTables(uint32_t tables[4][256], size_t len) {
+    uint32_t even[32], odd[32];
+
+    // Opérateur d’un bit nul, puis carrés successifs jusqu’à `len` octets
+    odd[0] = CRC32C_POLY;
+    for (int n = 1; n < 32; n++)
+        odd[n] = 1u << (n - 1);
+    gf2MatrixSquare(even, odd);     // 2 bits
+    gf2MatrixSquare(odd, even);     // 4 bits
+    uint32_t* op = odd;
+    for (;;) {
+        gf2MatrixSquare(even, odd); // 8, 32, 128… bits
+        op = even;
+        len >>= 1;
+        if (len == 0)
+            break;
+        gf2MatrixSquare(odd, even); // 16, 64, 256… bits
+        op = odd;
+        len >>= 1;
+        if (len == 0)
+            break;
+    }
+
+    for (uint32_t b = 0; b < 256; b++) {
+        tables[0][b] = gf2MatrixTimes(op, b);
+        tables[1][b] = gf2MatrixTimes(op, b << 8);
+        tables[2][b] = gf2MatrixTimes(op, b << 16);
+        tables[3][b] = gf2MatrixTimes(op, b << 24);
+    }
+}
+
+/**
+ * @brief Décale un CRC à l’aide de tables construites par `buildShiftTables()`.
+ */
+static uint32_t shiftCrc(uint32_t tables[4][256], uint32_t crc) {
+    return tables[0][crc & 0xFF] ^ tables[1][(crc >> 8) & 0xFF] ^
+           tables[2][(crc >> 16) & 0xFF] ^ tables[3][crc >> 24];
+}
+
+/**
+ * @brief Construit les tables du slice-by-8 et détecte SSE4.2.
+ */
+static void initCrc32c(void) {
+    for (uint32_t b = 0; b < 256; b++) {
+        uint32_t crc = b;
+        for (int bit = 0; bit < 8; bit++)
+            crc = (crc >> 1) ^ (CRC32C_POLY & (0u - (crc & 1)));
+        crc_table[0][b] = crc;
+    }
+    for (uint32_t b = 0; b < 256; b++)
+        for (int k = 1; k < 8; k++)
+            crc_table[k][b] = (crc_table[k - 1][b] >> 8) ^ crc_table[0][crc_table[k - 1][b] & 0xFF];
+
+#ifdef CRC32C_HAVE_SSE42
+    __builtin_cpu_init();
+    use_hardware = __builtin_cpu_supports("sse4.2");
+    if (use_hardware) {
+        buildShiftTables(crc_long, CRC32C_LONG);
+        buildShiftTables(crc_short, CRC32C_SHORT);
+    }
+#endif
+}
+
+/**
+ * @brief Version logicielle : 8 octets par itération avec les tables du slice-by-8.
+ *
+ * Les mots de 8 octets sont lus en little-endian, ordre dans lequel le CRC réfléchi
+ * consomme les octets.
+ */
+static uint32_t crc32cSoftware(uint32_t crc, const unsigned char* p, size_t size) {
+    while (size >= 8) {
+        uint32_t lo = (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+        uint32_t hi = (uint32_t)p[4] | (uint32_t)p[5] << 8 | (uint32_t)p[6] << 16 | (uint32_t)p[7] << 24;
+        lo ^= crc;
+        crc = crc_table[7][lo & 0xFF] ^ crc_table[6][(lo >> 8) & 0xFF] ^
+              crc_table[5][(lo >> 16) & 0xFF] ^ crc_table[4][lo >> 24] ^
+              crc_table[3][hi & 0xFF] ^ crc_table[2][(hi >> 8) & 0xFF] ^
+              crc_table[1][(hi >> 16) & 0xFF] ^ crc_table[0][hi >> 24];
+        p += 8;
+        size -= 8;
+    }
+    while (size-- > 0)
+        crc = (crc >> 8) ^ crc_table[0][(crc ^ *p++) & 0xFF];
+    return crc;
+}
+
+#ifdef CRC32C_HAVE_SSE42
+/**
+ * @brief Trois CRC indépendants sur des blocs consécutifs de `block` octets, puis recollés.
+ *
+ * L’instruction `crc32` a une latence de trois cycles mais en accepte une par cycle :
+ * entrelacer trois flux la garde occupée.
+ */
+__attribute__((target("sse4.2")))
+static uint64_t crc32cThreeWay(uint64_t crc0, const unsigned char** p, size_t* size,
+                               size_t block, uint32_t tables[4][256]) {
+    while (*size >= 3 * block) {
+        const unsigned char* next = *p;
+        const unsigned char* end = next + block;
+        uint64_t crc1 = 0, crc2 = 0;
+        do {
+            uint64_t w0, w1, w2;
+            memcpy(&w0, next, sizeof(w0));
+            memcpy(&w1, next + block, sizeof(w1));
+            memcpy(&w2, next + 2 * block, sizeof(w2));
+            crc0 = _mm_crc32_u64(crc0, w0);
+            crc1 = _mm_crc32_u64(crc1, w1);
+            crc2 = _mm_crc32_u64(crc2, w2);
+            next += 8;
+        } while (next < end);
+        crc0 = shiftCrc(tables, (uint32_t)crc0) ^ crc1;
+        crc0 = shiftCrc(tables, (uint32_t)crc0) ^ crc2;
+        *p += 3 * block;
+        *size -= 3 * block;
+    }
+    return crc0;
+}
+
+/**
+ * @brief Version matérielle : instruction `crc32` de SSE4.2, 8 octets à la fois.
+ */
+__attribute__((target("sse4.2")))
+static uint32_t crc32cHardware(uint32_t crc, const unsigned char* p, size_t size) {
+    uint64_t crc64 = crc;
+    crc64 = crc32cThreeWay(crc64, &p, &size, CRC32C_LONG, crc_long);
+    crc64 = crc32cThreeWay(crc64, &p, &size, CRC32C_SHORT, crc_short);
+    while (size >= 8) {
+        uint64_t word;
+        memcpy(&word, p, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+        p += 8;
+        size -= 8;
+    }
+    crc = (uint32_t)crc64;
+    while (size-- > 0)
+        crc = _mm_crc32_u8(crc, *p++);
+    return crc;
+}
+#endif
+
+/**
+ * @brief Calcule ou prolonge le CRC32C d’une zone mémoire.
+ */
+uint32_t crc32c(uint32_t crc, const void* data, size_t size) {
+    pthread_once(&crc_once, initCrc32c);
+
+    const unsigned char* p = data;
+    crc = ~crc;
+#ifdef CRC32C_HAVE_SSE42
+    if (use_hardware)
+        return ~crc32cHardware(crc, p, size);
+#endif
+    return ~crc32cSoftware(crc, p, size);
+}
@@ -0,0 +1,32 @@
+/**
+ * @file crc32c.h
+ * @brief Somme de contrôle CRC32C (polynôme de Castagnoli) des snapshots et du journal.
+ *
+ * Sur x86-64, le calcul utilise l’instruction `crc32` de SSE4.2 (8 octets par
+ * instruction) lorsque le processeur la propose ; sinon, une version logicielle
+ * « slice-by-8 » traite 8 octets par itération à l’aide de tables précalculées.
+ * Les deux versions donnent le même résultat.
+ *
+ * @see snapshot.h
+ */
+
+#ifndef CRC32C_H
+#define CRC32C_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Calcule ou prolonge le CRC32C d’une zone mémoire.
+ *
+ * Un CRC calculé en plusieurs appels, en repassant le résultat précédent, est
+ * identique à celui de la zone entière.
+ *
+ * @param crc  CRC des données précédentes, ou 0 pour commencer.
+ * @param data Données à ajouter.
+ * @param size Taille des données en octets.
+ * @return Le CRC32C de toutes les données.
+ */
+uint32_t crc32c(uint32_t crc, const void* data, size_t size);
+
+#endif // CRC32C_H
@@ -12,12 +12,22 @@
  * @version 1.0
  */
 
+#define _DEFAULT_SOURCE
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "./struct.h"
 #include "./struct_functions.h"
 #include "./file_gestion.h"
+#include "./tokenizer.h"
+#include "./report.h"
+#include "./ranking.h"
+#include "./parallel.h"
 
 /**
  * @brief Vérifie la présence du fichier de données en argument.
@@ -31,169 +41,805 @@ int checkArguments(int argc) {
 }
 
 /**
- * @brief Analyse une ligne contenant les informations d’un cours.
+ * @brief Analyse les champs `nom;coef` d’une ligne de cours et l’ajoute au catalogue.
+ * @return L’indice du cours, ou -1 en cas d’erreur (mémorisée dans le tokenizer).
  */
-Course* parseCourseLine(char* line) {
-    if (line == NULL) return NULL;
-
-    char name[128];
+static int parseCourseFields(LineTokenizer* t, Prom* promo) {
+    Field name;
     float coeff;
 
-    if (sscanf(line, "%[^;];%f", name, &coeff) != 2)
-        return NULL;
+    if (nextField(t, &name) == -1 || nextDecimalField(t, &coeff) == -1)
+        return -1;
 
-    return createCourse(name, coeff);
+    int course_index = addCourseToPromN(promo, name.start, name.length, coeff);
+    if (course_index == -1)
+        return setTokenError(t, &name, "allocation impossible");
+    return course_index;
 }
 
 /**
- * @brief Analyse une ligne contenant les informations d’un étudiant.
+ * @brief Analyse les champs `numero;prenom;nom;age` d’une ligne d’étudiant et l’ajoute à la promotion.
+ * @return L’étudiant ajouté, ou NULL en cas d’erreur (mémorisée dans le tokenizer).
  */
-Student* parseStudentLine(char* line) {
-    if (line == NULL) return NULL;
-
+static Student* parseStudentFields(LineTokenizer* t, Prom* promo) {
     int id, age;
-    char firstname[128], lastname[128];
+    Field first_name, last_name;
+
+    if (nextIntField(t, &id) == -1 ||
+        nextField(t, &first_name) == -1 ||
+        nextField(t, &last_name) == -1 ||
+        nextIntField(t, &age) == -1)
+        return NULL;
 
-    if (sscanf(line, "%d;%[^;];%[^;];%d", &id, firstname, lastname, &age) != 4)
+    // Les noms sont copiés une seule fois, directement depuis la ligne
+    Student* s = createStudentN(promo->arena, id, first_name.start, first_name.length,
+                                last_name.start, last_name.length, age);
+    if (s == NULL) {
+        setTokenError(t, &first_name, "allocation impossible");
         return NULL;
+    }
+
+    if (addStudentToProm(promo, s) == -1) {
+        if (promo->arena == NULL)
+            destroyStudent(s);
+        setTokenError(t, NULL, "allocation impossible");
+        return NULL;
+    }
+    return s;
+}
+
+/**
+ * @brief Analyse les champs `numero;matiere;note` d’une ligne de note.
+ *
+ * L’étudiant est résolu par l’index de hachage et le cours par le catalogue.
+ *
+ * @return 0 si la ligne est valide, -1 sinon (erreur mémorisée dans le tokenizer).
+ */
+static int scanGradeFields(LineTokenizer* t, const Prom* promo, int* position, int* course_index, uint8_t* tenths) {
+    int id;
+    float grade;
+    Field id_field, course, grade_field;
 
-    return createStudent(id, firstname, lastname, age, 0);
+    id_field.start = t->cur;
+    if (nextIntField(t, &id) == -1 ||
+        nextField(t, &course) == -1)
+        return -1;
+    grade_field.start = t->cur;
+    if (nextDecimalField(t, &grade) == -1)
+        return -1;
+
+    *position = findStudentPosition(promo, id);
+    if (*position == -1)
+        return setTokenError(t, &id_field, "étudiant inconnu");
+
+    *course_index = findCourseByNameN(promo, course.start, course.length);
+    if (*course_index == -1)
+        return setTokenError(t, &course, "matière inconnue");
+
+    int value = gradeToTenths(grade);
+    if (value == -1)
+        return setTokenError(t, &grade_field, "note hors de l’intervalle 0–20");
+    *tenths = (uint8_t)value;
+    return 0;
+}
+
+/**
+ * @brief Analyse une ligne de note déjà découpée et met à jour les structures correspondantes.
+ * @return 0 si tout est OK, -1 si erreur (mémorisée dans le tokenizer).
+ */
+static int parseGradeFields(LineTokenizer* t, Prom* promo) {
+    int position, course_index;
+    uint8_t tenths;
+
+    if (scanGradeFields(t, promo, &position, &course_index, &tenths) == -1)
+        return -1;
+
+    if (addTenthsToStudent(promo, promo->students[position], course_index, tenths) == -1)
+        return setTokenError(t, NULL, "allocation impossible");
+    return 0;
+}
+
+/**
+ * @brief Analyse une ligne contenant les informations d’un cours et l’ajoute au catalogue.
+ */
+int parseCourseLine(char* line, Prom* promo) {
+    if (line == NULL || promo == NULL) return -1;
+
+    LineTokenizer t;
+    initTokenizer(&t, line, strlen(line), 0);
+    return parseCourseFields(&t, promo);
+}
+
+/**
+ * @brief Analyse une ligne contenant les informations d’un étudiant et l’ajoute à la promotion.
+ */
+Student* parseStudentLine(char* line, Prom* promo) {
+    if (line == NULL || promo == NULL) return NULL;
+
+    LineTokenizer t;
+    initTokenizer(&t, line, strlen(line), 0);
+    return parseStudentFields(&t, promo);
 }
 
 /**
  * @brief Analyse une ligne de note et met à jour les structures correspondantes.
  * @return 0 si tout est OK, -1 si erreur.
  */
-int parseGradeLine(char* line, Prom* promo, Course* allCourses[], int nbCourses) {
-    if (line == NULL || promo == NULL || allCourses == NULL)
+int parseGradeLine(char* line, Prom* promo) {
+    if (line == NULL || promo == NULL)
         return -1;
 
-    int id;
-    char course_name[128];
-    float grade;
+    LineTokenizer t;
+    initTokenizer(&t, line, strlen(line), 0);
+    return parseGradeFields(&t, promo);
+}
+
+/**
+ * @brief Indique si une ligne est un en-tête de section et laquelle.
+ * @return 1 pour ETUDIANTS, 2 pour MATIERES, 3 pour NOTES, 0 sinon.
+ */
+static int sectionOf(const char* line, size_t length) {
+    if (length >= 9 && memcmp(line, "ETUDIANTS", 9) == 0) return 1;
+    if (length >= 8 && memcmp(line, "MATIERES", 8) == 0) return 2;
+    if (length >= 5 && memcmp(line, "NOTES", 5) == 0) return 3;
+    return 0;
+}
 
-    if (sscanf(line, "%d;%[^;];%f", &id, course_name, &grade) != 3)
+/**
+ * @struct LineSource
+ * @brief Structure interne : source de lignes du chargement texte (fichier ou projection mémoire).
+ */
+typedef struct {
+    FILE* file;             /**< Fichier lu par `fgets`, ou NULL pour un tampon en mémoire. */
+    char buffer[256];       /**< Tampon de lecture du mode fichier. */
+    const char* cur;        /**< Mode mémoire : début de la prochaine ligne. */
+    const char* end;        /**< Mode mémoire : fin du tampon. */
+    int line_no;            /**< Numéro de la dernière ligne lue. */
+} LineSource;
+
+/**
+ * @brief Lit la ligne suivante d’une source.
+ *
+ * En mode fichier, une ligne plus longue que le tampon est consommée en entier
+ * et signalée par une longueur de -1.
+ *
+ * @param src    Source de lignes.
+ * @param line   Début de la ligne lue (non terminée par `'\0'` en mode mémoire).
+ * @param length Longueur de la ligne, `'\n'` compris s’il est présent ; -1 si la ligne est trop longue.
+ * @return 1 si une ligne a été lue, 0 à la fin de la source.
+ */
+static int readLine(LineSource* src, const char** line, long* length) {
+    if (src->file == NULL) {
+        if (src->cur >= src->end)
+            return 0;
+        const char* nl = memchr(src->cur, '\n', (size_t)(src->end - src->cur));
+        const char* next = (nl != NULL) ? nl + 1 : src->end;
+        *line = src->cur;
+        *length = next - src->cur;
+        src->cur = next;
+        src->line_no++;
+        return 1;
+    }
+
+    if (fgets(src->buffer, sizeof(src->buffer), src->file) == NULL)
+        return 0;
+    src->line_no++;
+    *line = src->buffer;
+    *length = (long)strlen(src->buffer);
+
+    if (*length == (long)sizeof(src->buffer) - 1 && src->buffer[*length - 1] != '\n') {
+        // Ligne tronquée : on saute la suite au lieu de la lire comme une nouvelle ligne
+        int c = fgetc(src->file);
+        if (c == EOF || c == '\n')
+            return 1;
+        while ((c = fgetc(src->file)) != EOF && c != '\n')
+            ;
+        *length = -1;
+    }
+    return 1;
+}
+
+/**
+ * @brief Position d’une source de lignes, pour y revenir après la passe de comptage.
+ */
+typedef struct {
+    long offset;            /**< Position dans le fichier (mode fichier). */
+    const char* cur;        /**< Position dans le tampon (mode mémoire). */
+    int line_no;            /**< Numéro de ligne à cette position. */
+} LinePosition;
+
+/** @brief Mémorise la position courante d’une source. @return 0 si succès, -1 sinon. */
+static int saveLinePosition(const LineSource* src, LinePosition* pos) {
+    pos->cur = src->cur;
+    pos->line_no = src->line_no;
+    pos->offset = (src->file != NULL) ? ftell(src->file) : 0;
+    return pos->offset == -1 ? -1 : 0;
+}
+
+/** @brief Replace une source à une position mémorisée. @return 0 si succès, -1 sinon. */
+static int restoreLinePosition(LineSource* src, const LinePosition* pos) {
+    src->cur = pos->cur;
+    src->line_no = pos->line_no;
+    if (src->file != NULL && fseek(src->file, pos->offset, SEEK_SET) != 0)
         return -1;
+    return 0;
+}
 
-    Student* s = NULL;
-    for (int i = 0; i < promo->num_students; i++) {
-        if (promo->students[i]->student_id == id) {
-            s = promo->students[i];
-            break;
+/**
+ * @struct NoteCount
+ * @brief Structure interne du pré-dimensionnement : notes d’un étudiant dans un cours.
+ */
+typedef struct {
+    int count;       /**< Nombre de notes trouvées pour le couple (étudiant, cours). */
+    int first_line;  /**< Numéro de la première ligne de note du couple. */
+} NoteCount;
+
+/**
+ * @brief Crée les inscriptions et réserve les tableaux de notes à partir des comptages.
+ *
+ * Les inscriptions manquantes sont créées dans l’ordre croissant de `first_line`,
+ * c’est-à-dire dans l’ordre où le chargement normal les aurait créées, et les listes
+ * des inscrits de chaque matière sont réservées à leur taille finale.
+ *
+ * @param promo  Promotion (étudiants et catalogue déjà chargés).
+ * @param counts Matrice étudiants × cours des comptages.
+ * @param order  Tableau de travail d’au moins `promo->num_courses` entiers.
+ * @return 0 si succès, -1 en cas d’erreur d’allocation.
+ */
+static int reserveFromCounts(Prom* promo, const NoteCount* counts, int* order) {
+    int nb_courses = promo->num_courses;
+    int status = 0;
+
+    // Listes des inscrits : au plus un inscrit de plus par couple ayant des notes
+    // (`order` sert d’abord à compter ces couples par matière)
+    memset(order, 0, sizeof(int) * nb_courses);
+    for (size_t cell = 0; cell < (size_t)promo->num_students * nb_courses; cell++)
+        order[cell % nb_courses] += counts[cell].count > 0;
+    for (int c = 0; c < nb_courses && status == 0; c++)
+        status = reserveCourseRoster(promo, c, promo->rosters[c].size + order[c]);
+
+    for (int i = 0; i < promo->num_students && status == 0; i++) {
+        Student* s = promo->students[i];
+        const NoteCount* row = &counts[(size_t)i * nb_courses];
+
+        // Cours à inscrire, triés par première apparition (tri par insertion, peu de cours)
+        int nb_new = 0;
+        for (int c = 0; c < nb_courses; c++) {
+            if (row[c].count == 0)
+                continue;
+            Enrollment* e = findEnrollment(s, c);
+            if (e != NULL) {
+                if (reserveGrades(promo->arena, &e->grades, e->grades.size + row[c].count) == -1)
+                    status = -1;
+                continue;
+            }
+            int k = nb_new++;
+            while (k > 0 && row[order[k - 1]].first_line > row[c].first_line) {
+                order[k] = order[k - 1];
+                k--;
+            }
+            order[k] = c;
+        }
+
+        if (reserveEnrollments(promo->arena, s, s->num_courses + nb_new) == -1)
+            status = -1;
+        for (int k = 0; k < nb_new && status == 0; k++) {
+            Enrollment* e = addEnrollmentToProm(promo, s, order[k]);
+            if (e == NULL || reserveGrades(promo->arena, &e->grades, row[order[k]].count) == -1)
+                status = -1;
         }
     }
-    if (s == NULL) return -1;
 
-    Course* c = NULL;
-    for (int i = 0; i < s->num_courses; i++) {
-        if (strcmp(course_name, s->courses[i]->course_name) == 0) {
-            c = s->courses[i];
+    return status;
+}
+
+/**
+ * @brief Passe de comptage sur la section NOTES pour allouer chaque tableau une seule fois.
+ *
+ * Compte les notes par couple (étudiant, cours), crée les inscriptions dans l’ordre
+ * de leur première note (le même ordre que le chargement normal) et réserve la
+ * taille exacte de chaque tableau de notes. La source est ensuite replacée au début
+ * de la section pour la lecture effective des notes.
+ *
+ * @return 0 si succès, -1 en cas d’erreur (le chargement reste possible sans pré-dimensionnement).
+ */
+static int presizeFromNotes(LineSource* src, Prom* promo) {
+    LinePosition start;
+    if (saveLinePosition(src, &start) == -1)
+        return -1;
+
+    int nb_courses = promo->num_courses;
+    if (promo->num_students == 0 || nb_courses == 0)
+        return 0;
+
+    NoteCount* counts = calloc((size_t)promo->num_students * nb_courses, sizeof(NoteCount));
+    int* order = malloc(sizeof(int) * nb_courses);
+    if (counts == NULL || order == NULL) {
+        free(counts);
+        free(order);
+        return -1;
+    }
+
+    const char* line;
+    long length;
+    while (readLine(src, &line, &length)) {
+        if (length == -1)
+            continue;
+        if (sectionOf(line, (size_t)length) != 0)
             break;
-        }
+
+        LineTokenizer t;
+        int position, course_index;
+        uint8_t tenths;
+        initTokenizer(&t, line, (size_t)length, src->line_no);
+        if (scanGradeFields(&t, promo, &position, &course_index, &tenths) == -1)
+            continue;
+
+        NoteCount* nc = &counts[(size_t)position * nb_courses + course_index];
+        if (nc->count++ == 0)
+            nc->first_line = src->line_no;
+    }
+
+    int status = reserveFromCounts(promo, counts, order);
+
+    free(counts);
+    free(order);
+
+    if (restoreLinePosition(src, &start) == -1)
+        return -1;
+    return status;
+}
+
+/**
+ * @struct ChunkCell
+ * @brief Structure interne du chargement parallèle : couple (étudiant, cours) présent dans un morceau.
+ */
+typedef struct {
+    size_t cell;         /**< Case du couple dans la matrice étudiants × cours. */
+    int count;           /**< Nombre de notes du couple dans le morceau. */
+    int first;           /**< Première note du couple dans le morceau ; après la fusion, position de départ parmi les notes du couple. */
+} ChunkCell;
+
+/**
+ * @struct ChunkError
+ * @brief Structure interne du chargement parallèle : erreur rencontrée dans un morceau.
+ */
+typedef struct {
+    int line;            /**< Numéro de ligne relatif au début du morceau. */
+    int column;          /**< Colonne fautive. */
+    const char* message; /**< Message d’erreur (chaîne statique). */
+} ChunkError;
+
+/**
+ * @struct NotesChunk
+ * @brief Structure interne du chargement parallèle : morceau de la section NOTES et résultats de son analyse.
+ */
+typedef struct {
+    const Prom* promo;       /**< Promotion (lue seulement pendant l’analyse). */
+    const char* begin;       /**< Début du morceau (début de ligne). */
+    const char* end;         /**< Fin du morceau (après un `'\n'` ou fin du fichier). */
+    const char* stop;        /**< En-tête de section trouvé dans le morceau, NULL sinon. */
+    int num_lines;           /**< Nombre de lignes analysées (jusqu’à `stop`). */
+    uint64_t* keys;          /**< Notes valides : couple dans les 32 bits de poids fort, rang dans le morceau dans ceux de poids faible. */
+    uint8_t* tenths;         /**< Valeur de chaque note valide, dans l’ordre du fichier. */
+    int num_records;         /**< Nombre de notes valides. */
+    int records_capacity;    /**< Capacité des tableaux `keys` et `tenths`. */
+    ChunkCell* cells;        /**< Couples (étudiant, cours) du morceau, dans l’ordre des cases. */
+    int num_cells;           /**< Nombre de couples. */
+    ChunkError* errors;      /**< Lignes rejetées, dans l’ordre du fichier. */
+    int num_errors;          /**< Nombre de lignes rejetées. */
+    int errors_capacity;     /**< Capacité du tableau `errors`. */
+    uint8_t** targets;       /**< Phase de remplissage : début des notes ajoutées à chaque couple (étudiant, cours). */
+    int first_student;       /**< Phase finale : premier étudiant traité. */
+    int last_student;        /**< Phase finale : étudiant suivant le dernier traité. */
+    int failed;              /**< 1 si une allocation a échoué. */
+} NotesChunk;
+
+/** @brief Taille minimale d’un morceau en mode automatique, pour ne pas lancer de threads sur de petits fichiers. */
+#define PARALLEL_MIN_CHUNK (1 << 20)
+
+/**
+ * @brief Regroupe les notes d’un morceau par couple (étudiant, cours).
+ *
+ * Les clés sont triées par base (les notes d’un même couple restent dans l’ordre du
+ * fichier), puis chaque suite de clés de même couple donne une entrée de `cells` :
+ * le coût et la mémoire suivent le nombre de notes du morceau, et non la taille de
+ * la promotion.
+ *
+ * @return 0 si succès, -1 en cas d’erreur d’allocation.
+ */
+static int groupChunkCells(NotesChunk* chunk) {
+    int n = chunk->num_records;
+    uint64_t* tmp = malloc(sizeof(uint64_t) * (n > 0 ? n : 1));
+    chunk->cells = malloc(sizeof(ChunkCell) * (n > 0 ? n : 1));
+    if (tmp == NULL || chunk->cells == NULL) {
+        free(tmp);
+        return -1;
     }
 
-    // Si le cours n’existe pas encore → création
-    if (c == NULL) {
-        float coeff = 0.0f;
-        int found = 0;
-        for (int j = 0; j < nbCourses; j++) {
-            if (strcmp(allCourses[j]->course_name, course_name) == 0) {
-                coeff = allCourses[j]->coeff;
-                found = 1;
+    uint64_t* sorted = radixSortKeys(chunk->keys, tmp, n);
+    free(sorted == tmp ? chunk->keys : tmp);
+    chunk->keys = sorted;
+
+    for (int r = 0; r < n; r++) {
+        size_t cell = (size_t)(sorted[r] >> 32);
+        if (chunk->num_cells == 0 || chunk->cells[chunk->num_cells - 1].cell != cell)
+            chunk->cells[chunk->num_cells++] = (ChunkCell){ cell, 0, (int)(uint32_t)sorted[r] };
+        chunk->cells[chunk->num_cells - 1].count++;
+    }
+    return 0;
+}
+
+/**
+ * @brief Phase 1 : analyse les lignes d’un morceau dans ses propres tampons.
+ */
+static void* parseNotesChunk(void* arg) {
+    NotesChunk* chunk = arg;
+    const Prom* promo = chunk->promo;
+    const char* cur = chunk->begin;
+
+    while (cur < chunk->end && !chunk->failed) {
+        const char* nl = memchr(cur, '\n', (size_t)(chunk->end - cur));
+        const char* next = (nl != NULL) ? nl + 1 : chunk->end;
+        size_t length = (size_t)(next - cur);
+
+        if (sectionOf(cur, length) != 0) {
+            chunk->stop = cur;
+            break;
+        }
+        chunk->num_lines++;
+
+        LineTokenizer t;
+        int position, course_index;
+        uint8_t tenths;
+        initTokenizer(&t, cur, length, chunk->num_lines);
+        cur = next;
+        if (isBlankLine(&t))
+            continue;
+
+        if (scanGradeFields(&t, promo, &position, &course_index, &tenths) == -1) {
+            if (chunk->num_errors == chunk->errors_capacity) {
+                int capacity = chunk->errors_capacity ? chunk->errors_capacity * 2 : 16;
+                ChunkError* tmp = realloc(chunk->errors, sizeof(ChunkError) * capacity);
+                if (tmp == NULL) {
+                    chunk->failed = 1;
+                    break;
+                }
+                chunk->errors = tmp;
+                chunk->errors_capacity = capacity;
+            }
+            chunk->errors[chunk->num_errors++] = (ChunkError){ t.line_no, t.error_column, t.error };
+            continue;
+        }
+
+        if (chunk->num_records == chunk->records_capacity) {
+            int capacity = chunk->records_capacity ? chunk->records_capacity * 2 : 1024;
+            uint64_t* keys = realloc(chunk->keys, sizeof(uint64_t) * capacity);
+            if (keys != NULL)
+                chunk->keys = keys;
+            uint8_t* values = realloc(chunk->tenths, capacity);
+            if (values != NULL)
+                chunk->tenths = values;
+            if (keys == NULL || values == NULL) {
+                chunk->failed = 1;
                 break;
             }
+            chunk->records_capacity = capacity;
         }
-        if (!found) return -1;
+        uint64_t cell = (uint64_t)position * promo->num_courses + course_index;
+        chunk->keys[chunk->num_records] = cell << 32 | (uint32_t)chunk->num_records;
+        chunk->tenths[chunk->num_records++] = tenths;
+    }
 
-        c = createCourse(course_name, coeff);
-        if (c == NULL) return -1;
+    if (!chunk->failed && groupChunkCells(chunk) == -1)
+        chunk->failed = 1;
+    return NULL;
+}
 
-        Course** tmp = realloc(s->courses, sizeof(Course*) * (s->num_courses + 1));
-        if (tmp == NULL) {
-            destroyCourse(c);
-            return -1;
-        }
+/**
+ * @brief Phase 2 : recopie les notes d’un morceau à leur place définitive.
+ *
+ * Après la fusion, `cells[].first` contient la position de la première note du
+ * morceau parmi les notes ajoutées au couple (étudiant, cours).
+ */
+static void* fillNotesChunk(void* arg) {
+    NotesChunk* chunk = arg;
+
+    const uint64_t* key = chunk->keys;
+    for (int c = 0; c < chunk->num_cells; c++) {
+        uint8_t* target = chunk->targets[chunk->cells[c].cell] + chunk->cells[c].first;
+        for (int k = 0; k < chunk->cells[c].count; k++)
+            target[k] = chunk->tenths[(uint32_t)*key++];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Phase 3 : recalcule sommes et moyennes d’une tranche d’étudiants.
+ *
+ * Les sommes de notes sont entières : les moyennes sont identiques au chargement séquentiel.
+ */
+static void* finishStudentsChunk(void* arg) {
+    NotesChunk* chunk = arg;
+    const Prom* promo = chunk->promo;
+
+    for (int i = chunk->first_student; i < chunk->last_student; i++)
+        refreshStudentTotals(promo, promo->students[i]);
+    return NULL;
+}
 
-        s->courses = tmp;
-        s->courses[s->num_courses++] = c;
+/**
+ * @brief Charge la section NOTES d’une source en mémoire avec plusieurs threads.
+ *
+ * La section est découpée en morceaux alignés sur les fins de ligne ; chaque thread
+ * analyse le sien dans ses propres tampons (notes, puis comptages des seuls couples
+ * étudiant, cours qu’il contient, obtenus par un tri par base). La fusion se fait ensuite dans l’ordre des morceaux : inscriptions créées
+ * dans l’ordre de première apparition, notes rangées dans l’ordre du fichier et
+ * erreurs affichées dans l’ordre des lignes. Le résultat est identique à celui du
+ * chargement séquentiel. La source est avancée jusqu’à la section suivante.
+ *
+ * @return 0 si succès, -1 en cas d’erreur d’allocation.
+ */
+static int loadNotesParallel(LineSource* src, Prom* promo, int num_threads) {
+    int nb_students = promo->num_students;
+    int nb_courses = promo->num_courses;
+    size_t region_size = (size_t)(src->end - src->cur);
+    if (region_size == 0)
+        return 0;
+    if (nb_students == 0 || nb_courses == 0)
+        num_threads = 1;   // aucune note ne peut être valide : seules les erreurs comptent
+
+    int nb_chunks = parallelThreadCount(num_threads, region_size / PARALLEL_MIN_CHUNK, region_size);
+    size_t nb_cells = (size_t)nb_students * nb_courses;
+    NotesChunk* chunks = calloc(nb_chunks, sizeof(NotesChunk));
+    NoteCount* counts = calloc(nb_cells > 0 ? nb_cells : 1, sizeof(NoteCount));
+    uint8_t** targets = calloc(nb_cells > 0 ? nb_cells : 1, sizeof(uint8_t*));
+    int* order = malloc(sizeof(int) * (nb_courses > 0 ? nb_courses : 1));
+    // Le couple (étudiant, cours) d’une note tient dans les 32 bits de poids fort de sa clé
+    int status = (chunks && counts && targets && order && nb_cells <= UINT32_MAX) ? 0 : -1;
+
+    // Découpage en morceaux de tailles voisines, chacun commençant en début de ligne
+    const char* cur = src->cur;
+    for (int k = 0; k < nb_chunks && status == 0; k++) {
+        const char* end = src->end;
+        if (k < nb_chunks - 1) {
+            end = src->cur + region_size / nb_chunks * (k + 1);
+            if (end < cur)
+                end = cur;
+            const char* nl = memchr(end, '\n', (size_t)(src->end - end));
+            end = (nl != NULL) ? nl + 1 : src->end;
+        }
+        chunks[k].promo = promo;
+        chunks[k].begin = cur;
+        chunks[k].end = end;
+        chunks[k].targets = targets;
+        cur = end;
     }
 
-    // Ajout de la note
-    float* tmp2 = realloc(c->grades->grades_array, sizeof(float) * (c->grades->size + 1));
-    if (tmp2 == NULL) return -1;
+    // Phase 1 : analyse
+    if (status == 0)
+        runParallel(chunks, sizeof(NotesChunk), nb_chunks, parseNotesChunk);
+
+    // Les morceaux situés après une éventuelle section suivante sont ignorés
+    int used = 0;
+    int base_line = src->line_no;
+    int base_record = 0;
+    while (status == 0 && used < nb_chunks) {
+        NotesChunk* chunk = &chunks[used++];
+        if (chunk->failed) {
+            status = -1;
+            break;
+        }
+        for (int e = 0; e < chunk->num_errors; e++) {
+            LineTokenizer t = { .line_no = base_line + chunk->errors[e].line,
+                                .error_column = chunk->errors[e].column,
+                                .error = chunk->errors[e].message };
+            reportTokenError(&t, "note");
+        }
 
-    c->grades->grades_array = tmp2;
-    c->grades->grades_array[c->grades->size++] = grade;
+        // Fusion des seuls couples du morceau ; first devient sa position de départ
+        for (int c = 0; c < chunk->num_cells; c++) {
+            ChunkCell* local = &chunk->cells[c];
+            NoteCount* total = &counts[local->cell];
+            if (total->count == 0)
+                total->first_line = base_record + local->first;
+            local->first = total->count;
+            total->count += local->count;
+        }
 
-    // Calcul des moyennes
-    float sum = 0;
-    for (int n = 0; n < c->grades->size; n++)
-        sum += c->grades->grades_array[n];
-    c->average = sum / c->grades->size;
+        base_line += chunk->num_lines;
+        base_record += chunk->num_records;
+        if (chunk->stop != NULL) {
+            src->cur = chunk->stop;
+            break;
+        }
+    }
+    if (status == 0 && (used == nb_chunks && chunks[nb_chunks - 1].stop == NULL))
+        src->cur = src->end;
+    src->line_no = base_line;
+
+    // Inscriptions et réservations exactes, puis emplacement des notes de chaque couple
+    if (status == 0 && nb_cells > 0)
+        status = reserveFromCounts(promo, counts, order);
+    for (int i = 0; i < nb_students && status == 0; i++) {
+        Student* s = promo->students[i];
+        for (int c = 0; c < nb_courses; c++) {
+            size_t cell = (size_t)i * nb_courses + c;
+            if (counts[cell].count == 0)
+                continue;
+            Grades* g = &findEnrollment(s, c)->grades;
+            targets[cell] = g->grades_array + g->size;
+            g->size += counts[cell].count;
+        }
+    }
 
-    float total = 0, total_coeff = 0;
-    for (int i = 0; i < s->num_courses; i++) {
-        total += s->courses[i]->average * s->courses[i]->coeff;
-        total_coeff += s->courses[i]->coeff;
+    // Phase 2 : remplissage, puis phase 3 : moyennes, par tranches d’étudiants
+    if (status == 0) {
+        runParallel(chunks, sizeof(NotesChunk), used, fillNotesChunk);
+
+        int per_chunk = (nb_students + nb_chunks - 1) / nb_chunks;
+        for (int k = 0; k < nb_chunks; k++) {
+            chunks[k].first_student = (k * per_chunk < nb_students) ? k * per_chunk : nb_students;
+            chunks[k].last_student = ((k + 1) * per_chunk < nb_students) ? (k + 1) * per_chunk : nb_students;
+        }
+        runParallel(chunks, sizeof(NotesChunk), nb_chunks, finishStudentsChunk);
     }
-    if (total_coeff > 0)
-        s->general_average = total / total_coeff;
 
-    return 0;
+    for (int k = 0; chunks != NULL && k < nb_chunks; k++) {
+        free(chunks[k].keys);
+        free(chunks[k].tenths);
+        free(chunks[k].errors);
+        free(chunks[k].cells);
+    }
+    free(chunks);
+    free(counts);
+    free(targets);
+    free(order);
+    return status;
 }
 
 /**
- * @brief Charge la promotion complète à partir d’un fichier texte.
+ * @brief Lit toutes les lignes d’une source et construit la promotion.
+ *
+ * Partagé par la lecture classique (`fgets`) et par la lecture en projection mémoire.
+ *
+ * @param num_threads Nombre de threads pour la section NOTES avec `LOAD_PARALLEL` (0 : automatique).
+ * @return La promotion chargée, ou NULL en cas d’erreur.
  */
-Prom* loadPromotionFromFile(char* filename) {
-    FILE* data = fopen(filename, "r");
-    if (data == NULL) {
-        fprintf(stderr, "Erreur : impossible d’ouvrir le fichier %s.\n", filename);
-        return NULL;
-    }
-
-    Prom* promo = createProm(200, 0);
+static Prom* loadPromotionFromSource(LineSource* src, int flags, int num_threads) {
+    Prom* promo = (flags & LOAD_ARENA) ? createArenaProm(200) : createProm(200, 0);
     if (promo == NULL) {
-        fclose(data);
         fprintf(stderr, "Erreur : allocation échouée pour la promotion.\n");
         return NULL;
     }
 
-    Course* allCourses[50];
-    int nbCourses = 0;
-    char line[256];
+    // Mode agrégats : la lecture reste séquentielle, sans comptage préalable
+    if (flags & LOAD_AGGREGATE_ONLY) {
+        promo->aggregate_only = 1;
+        flags &= ~(LOAD_PRESIZE | LOAD_PARALLEL);
+    }
+
+    static const char* const contexts[] = { NULL, "étudiant", "matière", "note" };
+    const char* line;
+    long length;
     int mode = 0;
 
-    while (fgets(line, sizeof(line), data)) {
-        if (strncmp(line, "ETUDIANTS", 9) == 0) { mode = 1; fgets(line, sizeof(line), data); continue; }
-        if (strncmp(line, "MATIERES", 8) == 0) { mode = 2; fgets(line, sizeof(line), data); continue; }
-        if (strncmp(line, "NOTES", 5) == 0) { mode = 3; fgets(line, sizeof(line), data); continue; }
-
-        if (mode == 1) {
-            Student* s = parseStudentLine(line);
-            if (!s) continue;
-            if (promo->num_students >= promo->capacity) {
-                promo->capacity *= 2;
-                Student** tmp = realloc(promo->students, sizeof(Student*) * promo->capacity);
-                if (!tmp) {
-                    destroyStudent(s);
-                    fclose(data);
+    while (readLine(src, &line, &length)) {
+        if (length == -1) {
+            if (mode != 0)
+                fprintf(stderr, "⚠️ Erreur ligne %d (%s) : ligne trop longue.\n", src->line_no, contexts[mode]);
+            continue;
+        }
+
+        int section = sectionOf(line, (size_t)length);
+        if (section != 0) {
+            mode = section;
+            readLine(src, &line, &length);   // ligne d’en-tête des colonnes
+            if (mode == 3 && (flags & LOAD_PARALLEL) && src->file == NULL) {
+                if (loadNotesParallel(src, promo, num_threads) == -1) {
+                    fprintf(stderr, "Erreur : chargement parallèle des notes impossible.\n");
+                    destroyProm(promo);
                     return NULL;
                 }
-                promo->students = tmp;
             }
-            promo->students[promo->num_students++] = s;
-        }
-        else if (mode == 2) {
-            Course* c = parseCourseLine(line);
-            if (c && nbCourses < 50)
-                allCourses[nbCourses++] = c;
+            else if (mode == 3 && (flags & LOAD_PRESIZE) && presizeFromNotes(src, promo) == -1) {
+                fprintf(stderr, "Erreur : pré-dimensionnement impossible.\n");
+                destroyProm(promo);
+                return NULL;
+            }
+            continue;
         }
-        else if (mode == 3) {
-            if (parseGradeLine(line, promo, allCourses, nbCourses) == -1)
-                fprintf(stderr, "⚠️ Erreur lors du traitement d'une ligne de note.\n");
+
+        LineTokenizer t;
+        initTokenizer(&t, line, (size_t)length, src->line_no);
+        if (mode == 0 || isBlankLine(&t))
+            continue;
+
+        int status;
+        if (mode == 1)
+            status = (parseStudentFields(&t, promo) == NULL) ? -1 : 0;
+        else if (mode == 2)
+            status = parseCourseFields(&t, promo);
+        else
+            status = parseGradeFields(&t, promo);
+
+        if (status == -1)
+            reportTokenError(&t, contexts[mode]);
+    }
+
+    return promo;
+}
+
+/**
+ * @brief Charge la promotion en lisant le fichier par projection mémoire.
+ */
+static Prom* loadPromotionFromMapping(char* filename, int flags, int num_threads) {
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+        fprintf(stderr, "Erreur : impossible d’ouvrir le fichier %s.\n", filename);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        fprintf(stderr, "Erreur : impossible de lire la taille du fichier %s.\n", filename);
+        close(fd);
+        return NULL;
+    }
+
+    LineSource src = { .file = NULL };
+    void* map = NULL;
+    size_t size = (size_t)st.st_size;
+    if (size > 0) {
+        map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+            fprintf(stderr, "Erreur : projection en mémoire du fichier %s impossible.\n", filename);
+            close(fd);
+            return NULL;
         }
+        madvise(map, size, MADV_SEQUENTIAL);
+        src.cur = map;
+        src.end = (const char*)map + size;
     }
+    close(fd);
+
+    Prom* promo = loadPromotionFromSource(&src, flags, num_threads);
+
+    if (map != NULL)
+        munmap(map, size);
+    return promo;
+}
+
+/**
+ * @brief Charge la promotion complète à partir d’un fichier texte.
+ */
+Prom* loadPromotionFromFile(char* filename) {
+    return loadPromotionFromFileEx(filename, LOAD_DEFAULT);
+}
+
+/**
+ * @brief Charge la promotion complète à partir d’un fichier texte, avec options.
+ */
+Prom* loadPromotionFromFileEx(char* filename, int flags) {
+    return loadPromotionFromFileParallel(filename, flags, 0);
+}
+
+/**
+ * @brief Charge la promotion complète à partir d’un fichier texte, en choisissant le nombre de threads.
+ */
+Prom* loadPromotionFromFileParallel(char* filename, int flags, int num_threads) {
+    // Le découpage de la section NOTES en morceaux suppose le fichier entier en mémoire
+    if (flags & (LOAD_MMAP | LOAD_PARALLEL))
+        return loadPromotionFromMapping(filename, flags, num_threads);
+
+    FILE* data = fopen(filename, "r");
+    if (data == NULL) {
+        fprintf(stderr, "Erreur : impossible d’ouvrir le fichier %s.\n", filename);
+        return NULL;
+    }
+
+    LineSource src = { .file = data };
+    Prom* promo = loadPromotionFromSource(&src, flags, 0);
 
     fclose(data);
     return promo;
@@ -204,331 +850,480 @@ Prom* loadPromotionFromFile(char* filename) {
  */
 void printPromotion(Prom* p) {
     printf("=== PROMOTION ===\n");
-    for (int i = 0; i < p->num_students; i++) {
-        Student* s = p->students[i];
-        printf("\n%d - %s %s, %d ans\n", s->student_id, s->first_name, s->last_name, s->age);
-        printf("Moyenne générale : %.2f\n", s->general_average);
-        for (int j = 0; j < s->num_courses; j++) {
-            Course* c = s->courses[j];
-            printf("  %s (coeff %.2f) - Moy: %.2f - Notes: ", c->course_name, c->coeff, c->average);
-            for (int k = 0; k < c->grades->size; k++) {
-                printf("%.1f ", c->grades->grades_array[k]);
-            }
-            printf("\n");
-        }
-    }
+    fflush(stdout);
+    if (writeReport(STDOUT_FILENO, p, REPORT_TEXT) == -1)
+        fprintf(stderr, "Erreur lors de l'affichage de la promotion.\n");
 }
 
 
+/**
+ * @struct BinaryBuffer
+ * @brief Structure interne : contenu complet d’un fichier binaire v1, écrit ou relu en un seul appel.
+ */
+typedef struct {
+    unsigned char* data;    /**< Contenu du fichier. */
+    size_t size;            /**< Taille du contenu en octets. */
+    size_t pos;             /**< Position courante d’écriture ou de lecture. */
+} BinaryBuffer;
+
+/** @brief Ajoute `n` octets au tampon (la place a été calculée à l’avance). */
+static void putBytes(BinaryBuffer* b, const void* src, size_t n) {
+    memcpy(b->data + b->pos, src, n);
+    b->pos += n;
+}
+
+/** @brief Lit `n` octets du tampon. @return 0 si succès, -1 si le fichier est trop court. */
+static int getBytes(BinaryBuffer* b, void* dst, size_t n) {
+    if (n > b->size - b->pos)
+        return -1;
+    memcpy(dst, b->data + b->pos, n);
+    b->pos += n;
+    return 0;
+}
+
+/** @brief Réserve `n` octets en lecture et renvoie leur adresse dans le tampon, ou NULL si le fichier est trop court. */
+static const unsigned char* getSpan(BinaryBuffer* b, size_t n) {
+    if (n > b->size - b->pos)
+        return NULL;
+    const unsigned char* span = b->data + b->pos;
+    b->pos += n;
+    return span;
+}
+
 /**
  * @brief Sauvegarde la promotion dans un fichier binaire.
- * @return 0 si succès, -1 sinon.
  */
 int saveInBinaryFile(char* filename, Prom* promo) {
+    return saveInBinaryFileEx(filename, promo, SAVE_DEFAULT);
+}
+
+/**
+ * @brief Sauvegarde la promotion dans un fichier binaire, avec options.
+ *
+ * Le fichier est d’abord entièrement sérialisé en mémoire, puis écrit en un seul appel.
+ *
+ * @return 0 si succès, -1 sinon.
+ */
+int saveInBinaryFileEx(char* filename, Prom* promo, int flags) {
     if (filename == NULL || promo == NULL) {
         fprintf(stderr, "Erreur : arguments invalides.\n");
         return -1;
     }
+    if (promo->aggregate_only) {
+        fprintf(stderr, "Erreur : promotion chargée sans ses notes, sauvegarde impossible.\n");
+        return -1;
+    }
 
-    FILE* data = fopen(filename, "wb");
-    if (data == NULL) {
-        fprintf(stderr, "Erreur : impossible d’écrire dans le fichier %s.\n", filename);
+    // Longueur (avec '\0') du nom de chaque cours, calculée une seule fois pour le catalogue
+    int* course_len = malloc(sizeof(int) * (promo->num_courses > 0 ? promo->num_courses : 1));
+    if (course_len == NULL) {
+        fprintf(stderr, "Erreur : allocation impossible pour la sauvegarde.\n");
         return -1;
     }
+    for (int c = 0; c < promo->num_courses; c++)
+        course_len[c] = (int)strlen(promo->courses[c].course_name) + 1;
+
+    // Taille exacte du fichier
+    int compact = (flags & SAVE_COMPACT) != 0;
+    size_t total = sizeof(int);
+    if (compact) {
+        total += 2 * sizeof(int);
+        for (int c = 0; c < promo->num_courses; c++)
+            total += sizeof(int) + course_len[c] + sizeof(float);
+    }
+    for (int i = 0; i < promo->num_students; i++) {
+        Student* s = promo->students[i];
+        if (s == NULL) continue;
 
-    if (fwrite(&promo->num_students, sizeof(int), 1, data) != 1) {
-        fprintf(stderr, "Erreur lors de l’écriture du nombre d’étudiants.\n");
-        fclose(data);
+        total += sizeof(float) + 3 * sizeof(int);
+        total += sizeof(int) + strlen(s->first_name) + 1;
+        total += sizeof(int) + strlen(s->last_name) + 1;
+        for (int j = 0; j < s->num_courses; j++) {
+            Enrollment* e = &s->courses[j];
+            total += compact ? sizeof(int) : sizeof(int) + course_len[e->course_index] + sizeof(float);
+            total += sizeof(float) + sizeof(int) + sizeof(float) * e->grades.size;
+        }
+    }
+
+    BinaryBuffer out = { malloc(total), total, 0 };
+    if (out.data == NULL) {
+        fprintf(stderr, "Erreur : allocation impossible pour la sauvegarde.\n");
+        free(course_len);
         return -1;
     }
 
+    // Mode compact : marqueur et nombre d’étudiants, puis catalogue écrit une seule fois
+    if (compact) {
+        int marker = BINARY_COMPACT_MARKER;
+        putBytes(&out, &marker, sizeof(int));
+        putBytes(&out, &promo->num_students, sizeof(int));
+        putBytes(&out, &promo->num_courses, sizeof(int));
+        for (int c = 0; c < promo->num_courses; c++) {
+            putBytes(&out, &course_len[c], sizeof(int));
+            putBytes(&out, promo->courses[c].course_name, course_len[c]);
+            putBytes(&out, &promo->courses[c].coeff, sizeof(float));
+        }
+    }
+    else {
+        putBytes(&out, &promo->num_students, sizeof(int));
+    }
+
     for (int i = 0; i < promo->num_students; i++) {
         Student* s = promo->students[i];
         if (s == NULL) continue;
 
-        if (fwrite(&s->general_average, sizeof(float), 1, data) != 1 ||
-            fwrite(&s->student_id, sizeof(int), 1, data) != 1 ||
-            fwrite(&s->num_courses, sizeof(int), 1, data) != 1 ||
-            fwrite(&s->age, sizeof(int), 1, data) != 1) {
-            fprintf(stderr, "Erreur lors de l’écriture des infos de l’étudiant %d.\n", s->student_id);
-            fclose(data);
-            return -1;
-        }
+        putBytes(&out, &s->general_average, sizeof(float));
+        putBytes(&out, &s->student_id, sizeof(int));
+        putBytes(&out, &s->num_courses, sizeof(int));
+        putBytes(&out, &s->age, sizeof(int));
 
         int len = strlen(s->first_name) + 1;
-        if (fwrite(&len, sizeof(int), 1, data) != 1 ||
-            fwrite(s->first_name, sizeof(char), len, data) != (size_t)len) {
-            fprintf(stderr, "Erreur lors de l’écriture du prénom de %d.\n", s->student_id);
-            fclose(data);
-            return -1;
-        }
+        putBytes(&out, &len, sizeof(int));
+        putBytes(&out, s->first_name, len);
 
         len = strlen(s->last_name) + 1;
-        if (fwrite(&len, sizeof(int), 1, data) != 1 ||
-            fwrite(s->last_name, sizeof(char), len, data) != (size_t)len) {
-            fprintf(stderr, "Erreur lors de l’écriture du nom de %d.\n", s->student_id);
-            fclose(data);
-            return -1;
-        }
+        putBytes(&out, &len, sizeof(int));
+        putBytes(&out, s->last_name, len);
 
         for (int j = 0; j < s->num_courses; j++) {
-            Course* c = s->courses[j];
-            if (c == NULL) continue;
-
-            len = strlen(c->course_name) + 1;
-            if (fwrite(&len, sizeof(int), 1, data) != 1 ||
-                fwrite(c->course_name, sizeof(char), len, data) != (size_t)len ||
-                fwrite(&c->coeff, sizeof(float), 1, data) != 1 ||
-                fwrite(&c->average, sizeof(float), 1, data) != 1 ||
-                fwrite(&c->grades->size, sizeof(int), 1, data) != 1) {
-                fprintf(stderr, "Erreur lors de l’écriture du cours '%s' de %s.\n",
-                        c->course_name, s->first_name);
-                fclose(data);
-                return -1;
-            }
+            Enrollment* e = &s->courses[j];
+            Course* c = &promo->courses[e->course_index];
 
-            if (c->grades->size > 0) {
-                if (fwrite(c->grades->grades_array, sizeof(float), c->grades->size, data) != (size_t)c->grades->size) {
-                    fprintf(stderr, "Erreur lors de l’écriture des notes du cours '%s'.\n", c->course_name);
-                    fclose(data);
-                    return -1;
-                }
+            if (compact) {
+                putBytes(&out, &e->course_index, sizeof(int));
+            }
+            else {
+                putBytes(&out, &course_len[e->course_index], sizeof(int));
+                putBytes(&out, c->course_name, course_len[e->course_index]);
+                putBytes(&out, &c->coeff, sizeof(float));
+            }
+            putBytes(&out, &e->average, sizeof(float));
+            putBytes(&out, &e->grades.size, sizeof(int));
+            // Le format v1 garde des notes en float : conversion depuis les dixièmes
+            for (int n = 0; n < e->grades.size; n++) {
+                float grade = tenthsToGrade(e->grades.grades_array[n]);
+                putBytes(&out, &grade, sizeof(float));
             }
         }
     }
+    free(course_len);
 
-    fclose(data);
-    return 0;
-}
+    FILE* data = fopen(filename, "wb");
+    if (data == NULL) {
+        fprintf(stderr, "Erreur : impossible d’écrire dans le fichier %s.\n", filename);
+        free(out.data);
+        return -1;
+    }
 
+    int status = 0;
+    if (fwrite(out.data, 1, out.size, data) != out.size) {
+        fprintf(stderr, "Erreur lors de l’écriture du fichier %s.\n", filename);
+        status = -1;
+    }
+    if (fclose(data) != 0)
+        status = -1;
+    free(out.data);
+    return status;
+}
 
 
 /**
  * @brief Charge une promotion depuis un fichier binaire.
  */
-Prom* loadPromotionFromBinaryFile(char* filename){ // This function read the binaryFile to restore the memory context
-    FILE* data = fopen(filename, "rb");
-    if (data == NULL){
-        return NULL;
+Prom* loadPromotionFromBinaryFile(char* filename){
+    return loadPromotionFromBinaryFileEx(filename, LOAD_DEFAULT);
+}
+
+/**
+ * @brief Lit le catalogue d’un fichier binaire compact et l’enregistre dans la promotion.
+ *
+ * Les cours sont ajoutés dans l’ordre du fichier : l’indice stocké dans chaque
+ * inscription est donc directement l’indice du catalogue de la promotion.
+ *
+ * @return 0 si succès, -1 si le catalogue est invalide.
+ */
+static int restoreCatalog(BinaryBuffer* in, Prom* promo) {
+    int nb_courses;
+    // Chaque cours occupe au moins 9 octets
+    if (getBytes(in, &nb_courses, sizeof(int)) == -1 ||
+        nb_courses < 0 || (size_t)nb_courses > (in->size - in->pos) / 9){
+        printf("Invalid number of courses in catalog\n");
+        return -1;
     }
 
+    for (int c = 0; c < nb_courses; c++){
+        int name_len;
+        float coeff;
+        const char* name = NULL;
+        if (getBytes(in, &name_len, sizeof(int)) == -1 || name_len <= 0 ||
+            (name = (const char*)getSpan(in, name_len)) == NULL ||
+            getBytes(in, &coeff, sizeof(float)) == -1){
+            printf("Error reading catalog course %d\n", c);
+            return -1;
+        }
+
+        // Un catalogue sauvegardé ne contient pas de doublon : l’indice doit être c
+        if (addCourseToPromN(promo, name, strnlen(name, name_len - 1), coeff) != c){
+            printf("Invalid catalog course %d\n", c);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Reconstruit une promotion à partir du contenu complet d’un fichier binaire v1.
+ *
+ * Les noms et les notes sont copiés directement depuis le tampon.
+ *
+ * @return La promotion, ou NULL si le contenu est invalide ou tronqué.
+ */
+static Prom* restoreFromBuffer(BinaryBuffer* in, int flags) {
     int nb_students;
-    if (fread(&nb_students, sizeof(int), 1, data) != 1){
+    if (getBytes(in, &nb_students, sizeof(int)) == -1){
         printf("Cannot read the number of students\n");
-        fclose(data);
         return NULL;
     }
 
-    if (nb_students < 0){
+    // Mode compact : le vrai nombre d’étudiants suit le marqueur
+    int compact = (nb_students == BINARY_COMPACT_MARKER);
+    if (compact && getBytes(in, &nb_students, sizeof(int)) == -1){
+        printf("Cannot read the number of students\n");
+        return NULL;
+    }
+
+    // Chaque étudiant occupe au moins 26 octets : un nombre plus grand trahit un fichier corrompu
+    if (nb_students < 0 || (size_t)nb_students > (in->size - in->pos) / 26){
         printf("Invalid number of students\n");
-        fclose(data);
         return NULL;
     }
 
-    Prom* promo = createProm(nb_students, nb_students);
+    Prom* promo = (flags & LOAD_ARENA) ? createArenaProm(nb_students) : createProm(nb_students, 0);
     if (promo == NULL){
         printf("Allocation error\n");
-        fclose(data);
         return NULL;
     }
-    
-    size_t len = 0;
-    for(int i = 0; i < nb_students; i++){
-        Student* s = malloc(sizeof(Student));
-        if (s == NULL){
-            printf("Cannot allocate student\n");
-            fclose(data);
-            return NULL;
-        }
 
-        if (fread(&s->general_average, sizeof(float), 1, data) != 1 ||
-            fread(&s->student_id, sizeof(int), 1, data) != 1 ||
-            fread(&s->num_courses, sizeof(int), 1, data) != 1 ||
-            fread(&s->age, sizeof(int), 1, data) != 1) {
+    // Mode compact : catalogue partagé, lu une seule fois
+    if (compact && restoreCatalog(in, promo) == -1){
+        destroyProm(promo);
+        return NULL;
+    }
+
+    for(int i = 0; i < nb_students; i++){
+        float general_average;
+        int student_id, nb_courses, age;
+        int first_len, last_len;
+
+        if (getBytes(in, &general_average, sizeof(float)) == -1 ||
+            getBytes(in, &student_id, sizeof(int)) == -1 ||
+            getBytes(in, &nb_courses, sizeof(int)) == -1 ||
+            getBytes(in, &age, sizeof(int)) == -1) {
             printf("Error reading student basic data\n");
-            free(s);
-            fclose(data);
-            return NULL;
-        }
-        
-        if (fread(&len, sizeof(int), 1, data) != 1){
-            printf("Error reading first_name length\n");
-            free(s);
-            fclose(data);
+            destroyProm(promo);
             return NULL;
         }
 
-        if (len <= 0 || len > 256){
-            printf("Invalid first_name length: %ld\n", len);
-            free(s);
-            fclose(data);
+        if (getBytes(in, &first_len, sizeof(int)) == -1){
+            printf("Error reading first_name length\n");
+            destroyProm(promo);
             return NULL;
         }
-
-        s->first_name = malloc(sizeof(char) * len);
-        if (s->first_name == NULL){
-            free(s);
-            fclose(data);
+        if (first_len <= 0){
+            printf("Invalid first_name length: %d\n", first_len);
+            destroyProm(promo);
             return NULL;
         }
-
-        if (fread(s->first_name, sizeof(char), len, data) != len){
+        const char* first_name = (const char*)getSpan(in, first_len);
+        if (first_name == NULL){
             printf("Error reading first_name\n");
-            free(s->first_name);
-            free(s);
-            fclose(data);
+            destroyProm(promo);
             return NULL;
         }
-        
 
-        if (fread(&len, sizeof(int), 1, data) != 1){
+        if (getBytes(in, &last_len, sizeof(int)) == -1){
             printf("Error reading last_name length\n");
-            free(s->first_name);
-            free(s);
-            fclose(data);
-            return NULL;
-        }
-        if (len <= 0 || len > 256){
-            printf("Invalid last_name length: %ld\n", len);
-            free(s->first_name);
-            free(s);
-            fclose(data);
+            destroyProm(promo);
             return NULL;
         }
-        s->last_name = malloc(len);
-        if (s->last_name == NULL){
-            free(s->first_name);
-            free(s);
-            fclose(data);
+        if (last_len <= 0){
+            printf("Invalid last_name length: %d\n", last_len);
+            destroyProm(promo);
             return NULL;
         }
-        if (fread(s->last_name, sizeof(char), len, data) != len){
+        const char* last_name = (const char*)getSpan(in, last_len);
+        if (last_name == NULL){
             printf("Error reading last_name\n");
-            free(s->first_name);
-            free(s->last_name);
-            free(s);
-            fclose(data);
+            destroyProm(promo);
             return NULL;
         }
 
-        promo->students[i] = s;
+        // Le dernier octet stocké est le '\0' final : il n’est pas relu
+        Student* s = createStudentN(promo->arena, student_id,
+                                    first_name, strnlen(first_name, first_len - 1),
+                                    last_name, strnlen(last_name, last_len - 1), age);
+        if (s == NULL){
+            printf("Cannot allocate student\n");
+            destroyProm(promo);
+            return NULL;
+        }
+        if (addStudentToProm(promo, s) == -1){
+            printf("Cannot index student\n");
+            if (promo->arena == NULL)
+                destroyStudent(s);
+            destroyProm(promo);
+            return NULL;
+        }
+        s->general_average = general_average;
 
-        s->courses = malloc(sizeof(Course*) * s->num_courses);
-        if (s->courses == NULL && s->num_courses > 0){
+        // À partir d’ici, l’étudiant appartient à la promotion : destroyProm() suffit en cas d’erreur
+        if (nb_courses < 0 || (size_t)nb_courses > (in->size - in->pos) / (compact ? 12 : 17)){   // taille minimale d’un cours
+            printf("Invalid number of courses: %d\n", nb_courses);
+            destroyProm(promo);
+            return NULL;
+        }
+        if (reserveEnrollments(promo->arena, s, nb_courses) == -1){
             printf("Cannot allocate courses array\n");
-            free(s->first_name);
-            free(s->last_name);
-            free(s);
-            fclose(data);
+            destroyProm(promo);
             return NULL;
         }
 
-        for(int j = 0; j < s->num_courses; j++){
-            Course* c = malloc(sizeof(Course));
-
-            if (c == NULL){
-                printf("Cannot allocate course\n");
-                destroyStudent(s);
-                fclose(data);
-                return NULL;
+        for(int j = 0; j < nb_courses; j++){
+            int nb_grades, course_index = -1;
+            float coeff = 0, average;
+            const char* course_name = NULL;
+            size_t course_len = 0;
+
+            if (compact){
+                // Indice dans le catalogue déjà restauré
+                if (getBytes(in, &course_index, sizeof(int)) == -1){
+                    printf("Error reading course index\n");
+                    destroyProm(promo);
+                    return NULL;
+                }
+                if (course_index < 0 || course_index >= promo->num_courses){
+                    printf("Invalid course index: %d\n", course_index);
+                    destroyProm(promo);
+                    return NULL;
+                }
+                course_name = promo->courses[course_index].course_name;
+                course_len = promo->courses[course_index].name_length;
             }
+            else {
+                int name_len;
+                if (getBytes(in, &name_len, sizeof(int)) == -1){
+                    printf("Error reading course_name length\n");
+                    destroyProm(promo);
+                    return NULL;
+                }
+                if (name_len <= 0){
+                    printf("Invalid course_name length: %d\n", name_len);
+                    destroyProm(promo);
+                    return NULL;
+                }
+                course_name = (const char*)getSpan(in, name_len);
+                if (course_name == NULL){
+                    printf("Error reading course_name\n");
+                    destroyProm(promo);
+                    return NULL;
+                }
+                course_len = strnlen(course_name, name_len - 1);
 
-            c->grades = malloc(sizeof(Grades));
-
-            if (c->grades == NULL){
-                printf("Cannot allocate grades\n");
-                free(c);
-                destroyStudent(s);
-                fclose(data);
-                return NULL;
+                if (getBytes(in, &coeff, sizeof(float)) == -1){
+                    printf("Error reading course data\n");
+                    destroyProm(promo);
+                    return NULL;
+                }
             }
 
-            if (fread(&len, sizeof(int), 1, data) != 1){
-                printf("Error reading course_name length\n");
-                free(c->grades);
-                free(c);
-                destroyStudent(s);
-                fclose(data);
-                return NULL;
-            }
-            if (len <= 0 || len > 256){
-                printf("Invalid course_name length: %ld\n", len);
-                free(c->grades);
-                free(c);
-                destroyStudent(s);
-                fclose(data);
+            if (getBytes(in, &average, sizeof(float)) == -1 ||
+                getBytes(in, &nb_grades, sizeof(int)) == -1){
+                printf("Error reading course data\n");
+                destroyProm(promo);
                 return NULL;
             }
-            
-            c->course_name = malloc(sizeof(char) * len);
 
-            if (c->course_name == NULL){
-                free(c->grades);
-                free(c);
-                destroyStudent(s);
-                fclose(data);
+            if (nb_grades < 0){
+                printf("Invalid grades size: %d\n", nb_grades);
+                destroyProm(promo);
                 return NULL;
             }
-            if (fread(c->course_name, sizeof(char), len, data) != len){
-                printf("Error reading course_name\n");
-                free(c->course_name);
-                free(c->grades);
-                free(c);
-                destroyStudent(s);
-                fclose(data);
+
+            // Les notes sont vérifiées présentes avant toute allocation
+            const unsigned char* grades = getSpan(in, sizeof(float) * (size_t)nb_grades);
+            if (grades == NULL){
+                printf("Error reading grades array\n");
+                destroyProm(promo);
                 return NULL;
             }
 
-
-            if (fread(&c->coeff, sizeof(float), 1, data) != 1 ||
-                fread(&c->average, sizeof(float), 1, data) != 1 ||
-                fread(&c->grades->size, sizeof(int), 1, data) != 1){
-                printf("Error reading course data\n");
-                free(c->course_name);
-                free(c->grades);
-                free(c);
-                destroyStudent(s);
-                fclose(data);
+            // Le nom du cours est résolu dans le catalogue partagé au lieu d’être copié
+            if (!compact)
+                course_index = addCourseToPromN(promo, course_name, course_len, coeff);
+            Enrollment* e = (course_index == -1) ? NULL : addEnrollmentToProm(promo, s, course_index);
+            if (e == NULL || reserveGrades(promo->arena, &e->grades, nb_grades) == -1){
+                printf("Cannot register course %.*s\n", (int)course_len, course_name);
+                destroyProm(promo);
                 return NULL;
             }
-            
-            if (c->grades->size < 0){
-                printf("Invalid grades size: %d\n", c->grades->size);
-                free(c->course_name);
-                free(c->grades);
-                free(c);
-                destroyStudent(s);
-                fclose(data);
-                return NULL;
+            e->average = average;
+
+            for (int n = 0; n < nb_grades; n++) {
+                float grade;
+                memcpy(&grade, grades + sizeof(float) * n, sizeof(float));
+                int tenths = gradeToTenths(grade);
+                if (tenths == -1){
+                    printf("Invalid grade: %g\n", grade);
+                    destroyProm(promo);
+                    return NULL;
+                }
+                e->grades.grades_array[n] = (uint8_t)tenths;
             }
+            e->grades.size = nb_grades;
+        }
 
-            c->grades->grades_array = malloc(sizeof(float)  * c->grades->size);
+        // Les moyennes sauvegardées sont restaurées telles quelles
+        refreshStudentSums(promo, s);
+    }
 
-            if (c->grades->grades_array == NULL && c->grades->size > 0){
-                free(c->course_name);
-                free(c->grades);
-                free(c);
-                destroyStudent(s);
-                fclose(data);
-                return NULL;
-            }
+    return promo;
+}
 
-            if ((int)fread(c->grades->grades_array, sizeof(float), c->grades->size, data) != c->grades->size){
-                printf("Error reading grades array\n");
-                free(c->grades->grades_array);
-                free(c->course_name);
-                free(c->grades);
-                free(c);
-                destroyStudent(s);
-                fclose(data);
-                return NULL;
-            }
+/**
+ * @brief Charge une promotion depuis un fichier binaire, avec options.
+ *
+ * Le fichier est lu en un seul appel, puis analysé en mémoire.
+ */
+Prom* loadPromotionFromBinaryFileEx(char* filename, int flags){ // This function read the binaryFile to restore the memory context
+    FILE* data = fopen(filename, "rb");
+    if (data == NULL){
+        return NULL;
+    }
 
-            s->courses[j] = c;
-        }
+    long size = -1;
+    if (fseek(data, 0, SEEK_END) == 0)
+        size = ftell(data);
+    if (size < 0 || fseek(data, 0, SEEK_SET) != 0){
+        printf("Cannot read the file size\n");
+        fclose(data);
+        return NULL;
     }
 
+    BinaryBuffer in = { malloc(size > 0 ? (size_t)size : 1), (size_t)size, 0 };
+    if (in.data == NULL){
+        printf("Allocation error\n");
+        fclose(data);
+        return NULL;
+    }
+    if (fread(in.data, 1, in.size, data) != in.size){
+        printf("Cannot read the file\n");
+        free(in.data);
+        fclose(data);
+        return NULL;
+    }
     fclose(data);
 
+    Prom* promo = restoreFromBuffer(&in, flags);
+    free(in.data);
     return promo;
 }
@@ -18,6 +18,33 @@
 
 #include "./struct.h"
 
+/** @brief Chargement simple : les tableaux grandissent géométriquement au fil des notes. */
+#define LOAD_DEFAULT 0x0
+
+/** @brief Passe de comptage préalable sur NOTES : chaque tableau de notes et d’inscriptions est alloué une seule fois. */
+#define LOAD_PRESIZE 0x1
+
+/** @brief Promotion en mode arène : étudiants, noms et notes sont alloués par blocs et libérés en une fois. */
+#define LOAD_ARENA 0x2
+
+/** @brief Lecture du fichier texte par projection mémoire (`mmap`) au lieu de `fgets`, sans limite de longueur de ligne. */
+#define LOAD_MMAP 0x4
+
+/** @brief Section NOTES analysée par plusieurs threads (implique `LOAD_MMAP`), avec un résultat identique au chargement séquentiel. */
+#define LOAD_PARALLEL 0x8
+
+/** @brief Notes lues en flux : seuls l’effectif, la somme et les extrêmes de chaque couple (étudiant, cours) sont gardés. */
+#define LOAD_AGGREGATE_ONLY 0x10
+
+/** @brief Sauvegarde binaire au format historique (nom et coefficient du cours répétés dans chaque inscription). */
+#define SAVE_DEFAULT 0x0
+
+/** @brief Sauvegarde binaire compacte : catalogue écrit une fois, chaque inscription ne stocke que l’indice du cours. */
+#define SAVE_COMPACT 0x1
+
+/** @brief Premier entier d’un fichier binaire compact (un nombre d’étudiants ne peut pas être négatif). */
+#define BINARY_COMPACT_MARKER (-1)
+
 /**
  * @brief Vérifie que le fichier de données est passé en argument au programme.
  * @param argc Nombre d’arguments passés au programme.
@@ -26,32 +53,32 @@
 int checkArguments(int argc);
 
 /**
- * @brief Analyse une ligne décrivant un cours et crée la structure correspondante.
- * @param line Ligne du fichier contenant le nom du cours et son coefficient.
- * @return Un pointeur vers une structure Course allouée dynamiquement, ou NULL en cas d’erreur.
+ * @brief Analyse une ligne décrivant un cours et l’ajoute au catalogue de la promotion.
+ * @param line  Ligne du fichier contenant le nom du cours et son coefficient.
+ * @param promo Pointeur vers la promotion dont le catalogue est complété.
+ * @return L’indice du cours dans le catalogue, ou -1 en cas d’erreur.
  */
-Course* parseCourseLine(char* line);
+int parseCourseLine(char* line, Prom* promo);
 
 /**
- * @brief Analyse une ligne décrivant un étudiant et crée la structure correspondante.
- * @param line Ligne du fichier contenant les informations de l'étudiant (id, prénom, nom, âge).
- * @return Un pointeur vers une structure Student allouée dynamiquement, ou NULL en cas d’erreur.
+ * @brief Analyse une ligne décrivant un étudiant, crée la structure correspondante et l’ajoute à la promotion.
+ * @param line  Ligne du fichier contenant les informations de l'étudiant (id, prénom, nom, âge).
+ * @param promo Promotion à compléter (l’étudiant est alloué dans son arène si elle en a une).
+ * @return Un pointeur vers l’étudiant ajouté, ou NULL en cas d’erreur.
  */
-Student* parseStudentLine(char* line);
+Student* parseStudentLine(char* line, Prom* promo);
 
 /**
  * @brief Analyse une ligne décrivant une note et met à jour les structures correspondantes.
  * 
- * Cette fonction recherche l'étudiant et le cours concernés,
+ * Cette fonction recherche l'étudiant (via l’index de hachage) et le cours (dans le catalogue),
  * ajoute la note, puis met à jour la moyenne du cours et la moyenne générale de l’étudiant.
  *
  * @param line Ligne du fichier contenant l’identifiant de l’étudiant, le nom du cours et la note.
- * @param promo Pointeur vers la promotion en mémoire.
- * @param allCourses Tableau de pointeurs vers les cours disponibles.
- * @param nbCourses Nombre total de cours enregistrés.
+ * @param promo Pointeur vers la promotion en mémoire (étudiants et catalogue des matières).
  * @return Code d'erreur
  */
-int parseGradeLine(char* line, Prom* promo, Course* allCourses[], int nbCourses);
+int parseGradeLine(char* line, Prom* promo);
 
 /**
  * @brief Charge une promotion complète à partir d’un fichier texte.
@@ -61,16 +88,67 @@ int parseGradeLine(char* line, Prom* promo, Course* allCourses[], int nbCourses)
  * - `MATIERES`
  * - `NOTES`
  *
+ * Les lignes vides sont ignorées. Une ligne mal formée est signalée sur la sortie
+ * d’erreur avec son numéro et la colonne fautive, puis ignorée.
+ *
  * @param filename Nom du fichier texte à charger.
  * @return Un pointeur vers la structure Prom allouée dynamiquement, ou NULL en cas d’erreur.
  */
 Prom* loadPromotionFromFile(char* filename);
 
+/**
+ * @brief Charge une promotion complète à partir d’un fichier texte, avec options.
+ *
+ * Identique à `loadPromotionFromFile()`, avec en plus des options de chargement
+ * combinables par OU binaire (`LOAD_PRESIZE`, `LOAD_ARENA`, ...).
+ * Avec `LOAD_PRESIZE`, une première lecture de la section `NOTES` compte les notes
+ * de chaque couple (étudiant, cours) : le nombre d’allocations ne dépend alors plus
+ * du nombre de lignes de notes mais du nombre d’inscriptions.
+ * Avec `LOAD_ARENA`, la promotion est créée par `createArenaProm()` ; combinée à
+ * `LOAD_PRESIZE`, le chargement ne fait plus que quelques appels à l’allocateur.
+ * Avec `LOAD_MMAP`, le fichier est projeté en mémoire et analysé en place
+ * (lecture séquentielle signalée au noyau par `madvise()`) : aucune copie par
+ * `stdio`, et les noms sont copiés une seule fois depuis la projection.
+ * Avec `LOAD_PARALLEL`, la section `NOTES` est découpée en morceaux analysés
+ * en parallèle (un thread par cœur, morceaux d’au moins 1 Mio) ; voir
+ * `loadPromotionFromFileParallel()`.
+ * Avec `LOAD_AGGREGATE_ONLY`, chaque ligne de note ne met à jour que les agrégats
+ * de son inscription (`Grades.size`, `sum`, `min`, `max`) : aucun tableau de notes
+ * n’est alloué et la mémoire ne dépend que du nombre d’inscriptions, quel que soit
+ * le nombre de lignes de notes. Moyennes et classements sont identiques ; les notes
+ * individuelles ne peuvent plus être affichées ni sauvegardées. `LOAD_PRESIZE` et
+ * `LOAD_PARALLEL`, qui conservent les notes, sont alors ignorées.
+ *
+ * @param filename Nom du fichier texte à charger.
+ * @param flags    Options de chargement (`LOAD_DEFAULT` pour le comportement standard).
+ * @return Un pointeur vers la structure Prom allouée dynamiquement, ou NULL en cas d’erreur.
+ */
+Prom* loadPromotionFromFileEx(char* filename, int flags);
+
+/**
+ * @brief Charge une promotion à partir d’un fichier texte en fixant le nombre de threads.
+ *
+ * Identique à `loadPromotionFromFileEx()`. Avec `LOAD_PARALLEL`, la section `NOTES`
+ * est découpée en `num_threads` morceaux alignés sur les fins de ligne ; chaque
+ * thread analyse le sien dans ses propres tampons, à la taille de ses notes (et
+ * non de la promotion), puis la fusion se fait dans
+ * l’ordre du fichier : inscriptions, ordre des notes, moyennes et messages
+ * d’erreur sont identiques à ceux du chargement séquentiel.
+ *
+ * @param filename    Nom du fichier texte à charger.
+ * @param flags       Options de chargement.
+ * @param num_threads Nombre de threads (0 : un par cœur disponible, selon la taille du fichier).
+ * @return Un pointeur vers la structure Prom allouée dynamiquement, ou NULL en cas d’erreur.
+ */
+Prom* loadPromotionFromFileParallel(char* filename, int flags, int num_threads);
+
 /**
  * @brief Affiche les informations d'une promotion.
  * 
  * Affiche les étudiants, leurs cours, leurs notes,
  * les moyennes par matière et les moyennes générales.
+ * Après l’en-tête, le contenu est écrit par `writeReport()` au format `REPORT_TEXT`
+ * (voir `report.h`) : mis en forme dans un tampon et envoyé par gros blocs.
  *
  * @param p Pointeur vers la promotion à afficher.
  */
@@ -88,15 +166,44 @@ void printPromotion(Prom* p);
  */
 int saveInBinaryFile(char* filename, Prom* promo);
 
+/**
+ * @brief Sauvegarde la promotion dans un fichier binaire, avec options.
+ *
+ * Avec `SAVE_COMPACT`, le fichier commence par `BINARY_COMPACT_MARKER`, le nombre
+ * d’étudiants puis le catalogue (nom et coefficient de chaque cours, une seule fois) ;
+ * chaque inscription stocke ensuite l’indice du cours au lieu de son nom et de son
+ * coefficient. Le reste est identique au format historique, et
+ * `loadPromotionFromBinaryFile()` relit les deux variantes.
+ *
+ * @param filename Nom du fichier binaire de destination.
+ * @param promo    Pointeur vers la promotion à sauvegarder.
+ * @param flags    `SAVE_DEFAULT` ou `SAVE_COMPACT`.
+ * @return Code d'erreur
+ */
+int saveInBinaryFileEx(char* filename, Prom* promo, int flags);
+
 /**
  * @brief Restaure une promotion à partir d’un fichier binaire.
  * 
  * Recrée en mémoire toutes les structures à partir des données binaires
- * précédemment sauvegardées avec `saveInBinaryFile()`.
+ * précédemment sauvegardées avec `saveInBinaryFile()` (formats historique et compact).
+ * Dans les deux cas, chaque cours n’est stocké qu’une fois, dans le catalogue de la promotion.
  *
  * @param filename Nom du fichier binaire à lire.
  * @return Un pointeur vers la structure Prom restaurée, ou NULL en cas d’erreur.
  */
 Prom* loadPromotionFromBinaryFile(char* filename);
 
+/**
+ * @brief Restaure une promotion à partir d’un fichier binaire, avec options.
+ *
+ * Seule l’option `LOAD_ARENA` est prise en compte : toute la promotion restaurée
+ * est alors allouée dans une arène et libérée en une fois par `destroyProm()`.
+ *
+ * @param filename Nom du fichier binaire à lire.
+ * @param flags    Options de chargement (`LOAD_DEFAULT` ou `LOAD_ARENA`).
+ * @return Un pointeur vers la structure Prom restaurée, ou NULL en cas d’erreur.
+ */
+Prom* loadPromotionFromBinaryFileEx(char* filename, int flags);
+
 #endif // FILE_GESTION_H
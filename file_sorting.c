@@ -3,20 +3,28 @@
  * @brief Implémentation des fonctions permettant de trier et sélectionner les meilleurs étudiants d’une promotion.
  *
  * Ce fichier contient l’implémentation des algorithmes utilisés pour :
- * - trier les étudiants selon leur moyenne générale (`compareStudents`, `getTopTenStudents`) ;
- * - déterminer les meilleurs étudiants d’un cours donné (`getTopThreeStudentsCourse`).
+ * - trier les étudiants selon leur moyenne générale (`compareStudents`) ;
+ * - sélectionner les meilleurs étudiants de la promotion par un tas (`getTopKStudents`, `getTopTenStudents`) ;
+ * - déterminer les meilleurs étudiants d’un cours donné à partir de la liste de ses
+ *   inscrits (`getTopKStudentsCourse`, `getTopThreeStudentsCourse`).
  *
- * Ces fonctions s’appuient sur le tri rapide de la bibliothèque standard (`qsort`)
- * et utilisent des copies de tableaux pour ne pas modifier l’ordre d’origine des étudiants.
+ * Si la promotion tient des classements (`leaderboard.h`), les sélections les
+ * lisent directement au lieu de parcourir les étudiants.
+ *
+ * Ces fonctions ne modifient jamais l’ordre d’origine des étudiants : la sélection
+ * travaille dans le tableau fourni par l’appelant.
  *
  * @see file_sorting.h
  */
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include "./struct.h"
+#include "./struct_functions.h"
 #include "./file_gestion.h"
+#include "./leaderboard.h"
 
 /**
  * @brief Compare deux étudiants selon leur moyenne générale (utilisée avec qsort).
@@ -33,130 +41,217 @@ int compareStudents(const void* a, const void* b) {
 }
 
 /**
- * @brief Retourne les 10 meilleurs étudiants d’une promotion.
+ * @brief Indique si l’étudiant `a` précède `b` dans la promotion (départage des égalités).
  */
-Student** getTopTenStudents(Prom* promo, int* count) {
-    if (promo == NULL || promo->num_students <= 0)
-        return NULL;
+static int comesBefore(const Prom* promo, const Student* a, const Student* b) {
+    int pa = findStudentPosition(promo, a->student_id);
+    int pb = findStudentPosition(promo, b->student_id);
+    if (pa != pb)
+        return pa < pb;
+    return (uintptr_t)a < (uintptr_t)b;   // identifiants dupliqués
+}
 
-    if (promo->num_students < 10) {
-        *count = promo->num_students;
+/**
+ * @brief Indique si l’étudiant `a` est classé avant `b` : meilleure moyenne, puis position dans la promotion.
+ *
+ * La position n’est recherchée qu’en cas d’égalité des moyennes.
+ */
+static int ranksBefore(const Prom* promo, const Student* a, const Student* b) {
+    if (a->general_average != b->general_average)
+        return a->general_average > b->general_average;
+    return comesBefore(promo, a, b);
+}
+
+/**
+ * @brief Fait descendre un élément du tas, dont la racine est le moins bien classé.
+ */
+static void siftDownWorst(const Prom* promo, Student** heap, int size, int i) {
+    for (;;) {
+        int worst = i;
+        int left = 2 * i + 1, right = left + 1;
+        if (left < size && ranksBefore(promo, heap[worst], heap[left]))
+            worst = left;
+        if (right < size && ranksBefore(promo, heap[worst], heap[right]))
+            worst = right;
+        if (worst == i)
+            return;
+
+        Student* tmp = heap[i];
+        heap[i] = heap[worst];
+        heap[worst] = tmp;
+        i = worst;
     }
-    else {
-        *count = 10;
+}
+
+/**
+ * @brief Sélectionne les `k` meilleurs étudiants d’une promotion.
+ */
+int getTopKStudents(const Prom* promo, int k, Student** out, int* count) {
+    if (count != NULL)
+        *count = 0;
+    if (promo == NULL || out == NULL || count == NULL || k < 0)
+        return -1;
+
+    // Classement tenu à jour : les k premiers se lisent directement
+    int ranked = leaderboardTopStudents(promo, k, out);
+    if (ranked != -1) {
+        *count = ranked;
+        return 0;
     }
 
-    Student** copy = malloc(sizeof(Student*) * promo->num_students);
-    if (copy == NULL)
-        return NULL;
+    int size = (k < promo->num_students) ? k : promo->num_students;
+    if (size == 0)
+        return 0;
 
-    memcpy(copy, promo->students, sizeof(Student*) * promo->num_students);
-    qsort(copy, promo->num_students, sizeof(Student*), compareStudents);
+    // Tas des `size` premiers, puis un étudiant n’entre que s’il bat le moins bien classé ;
+    // arrivé plus tard, il ne le bat jamais à moyenne égale
+    for (int i = 0; i < size; i++)
+        out[i] = promo->students[i];
+    for (int i = size / 2 - 1; i >= 0; i--)
+        siftDownWorst(promo, out, size, i);
 
-    Student** top_ten = malloc(sizeof(Student*) * (*count));
-    if (top_ten == NULL) {
-        free(copy);
-        return NULL;
+    for (int i = size; i < promo->num_students; i++) {
+        Student* s = promo->students[i];
+        if (s->general_average > out[0]->general_average) {
+            out[0] = s;
+            siftDownWorst(promo, out, size, 0);
+        }
     }
 
-    for (int i = 0; i < *count; i++) {
-        top_ten[i] = copy[i];
+    // Tri par tas : le moins bien classé part à la fin à chaque étape
+    for (int end = size - 1; end > 0; end--) {
+        Student* tmp = out[0];
+        out[0] = out[end];
+        out[end] = tmp;
+        siftDownWorst(promo, out, end, 0);
     }
 
-    free(copy);
+    *count = size;
+    return 0;
+}
+
+/**
+ * @brief Retourne les 10 meilleurs étudiants d’une promotion.
+ */
+Student** getTopTenStudents(Prom* promo, int* count) {
+    if (promo == NULL || promo->num_students <= 0)
+        return NULL;
+
+    int k = (promo->num_students < 10) ? promo->num_students : 10;
+    Student** top_ten = malloc(sizeof(Student*) * k);
+    if (top_ten == NULL)
+        return NULL;
+
+    getTopKStudents(promo, k, top_ten, count);
     return top_ten;
 }
 
 /**
- * @struct StudentCourseAvg
- * @brief Structure interne associant un étudiant à sa moyenne dans un cours donné.
+ * @brief Moyenne d’un inscrit dans la matière de sa liste.
  */
-typedef struct {
-    Student* s;      /**< Pointeur vers l’étudiant */
-    float moyenne;   /**< Moyenne obtenue dans le cours */
-} StudentCourseAvg;
+static float rosterAverage(const RosterEntry* entry) {
+    return entry->student->courses[entry->enrollment].average;
+}
 
 /**
- * @brief Compare deux structures `StudentCourseAvg` selon leur moyenne.
+ * @brief Indique si l’inscrit `a` est classé avant `b` : meilleure moyenne dans la matière, puis position.
  */
-int compareCourseAvg(const void* a, const void* b) {
-    const StudentCourseAvg* sa = (const StudentCourseAvg*)a;
-    const StudentCourseAvg* sb = (const StudentCourseAvg*)b;
-    if (sa->moyenne < sb->moyenne) return 1;
-    if (sa->moyenne > sb->moyenne) return -1;
-    return 0;
+static int rosterRanksBefore(const Prom* promo, const RosterEntry* a, const RosterEntry* b) {
+    float avg_a = rosterAverage(a), avg_b = rosterAverage(b);
+    if (avg_a != avg_b)
+        return avg_a > avg_b;
+    return comesBefore(promo, a->student, b->student);
 }
 
 /**
- * @brief Retourne les 3 meilleurs étudiants d’un cours spécifique.
+ * @brief Fait descendre un élément du tas des inscrits, dont la racine est le moins bien classé.
  */
-Student** getTopThreeStudentsCourse(Prom* promo, const char* course_name, int* top_count) {
-    if (promo == NULL || course_name == NULL || promo->num_students == 0) {
-        *top_count = 0;
-        return NULL;
-    }
+static void siftDownWorstEntry(const Prom* promo, RosterEntry* heap, int size, int i) {
+    for (;;) {
+        int worst = i;
+        int left = 2 * i + 1, right = left + 1;
+        if (left < size && rosterRanksBefore(promo, &heap[worst], &heap[left]))
+            worst = left;
+        if (right < size && rosterRanksBefore(promo, &heap[worst], &heap[right]))
+            worst = right;
+        if (worst == i)
+            return;
 
-    // Compter les étudiants concernés
-    int count = 0;
-    for (int i = 0; i < promo->num_students; i++) {
-        Student* s = promo->students[i];
-        for (int j = 0; j < s->num_courses; j++) {
-            if (strcmp(s->courses[j]->course_name, course_name) == 0) {
-                count++;
-                break;
-            }
-        }
+        RosterEntry tmp = heap[i];
+        heap[i] = heap[worst];
+        heap[worst] = tmp;
+        i = worst;
     }
+}
 
-    if (count == 0) {
-        *top_count = 0;
-        printf("This course doesn't exist\n");
-        return NULL;
-    }
+/**
+ * @brief Sélectionne les `k` meilleurs inscrits d’une matière.
+ */
+int getTopKStudentsCourse(const Prom* promo, const char* course_name, int k, RosterEntry* out, int* count) {
+    if (count != NULL)
+        *count = 0;
+    if (promo == NULL || course_name == NULL || out == NULL || count == NULL || k < 0)
+        return -1;
 
-    // Stocker les moyennes de chaque étudiant dans la matière
-    StudentCourseAvg* savg = malloc(sizeof(StudentCourseAvg) * count);
-    if (savg == NULL) {
-        *top_count = 0;
-        return NULL;
-    }
+    // Le nom du cours est résolu une seule fois dans le catalogue
+    int course_index = findCourseByName(promo, course_name);
+    if (course_index == -1)
+        return -1;
 
-    int idx = 0;
-    for (int i = 0; i < promo->num_students; i++) {
-        Student* s = promo->students[i];
-        for (int j = 0; j < s->num_courses; j++) {
-            Course* c = s->courses[j];
-            if (strcmp(c->course_name, course_name) == 0) {
-                savg[idx].s = s;
-                savg[idx].moyenne = c->average;
-                idx++;
-                break;
-            }
-        }
+    int ranked = leaderboardTopCourse(promo, course_index, k, out);
+    if (ranked != -1) {
+        *count = ranked;
+        return 0;
     }
 
-    // Étape 3 : trier les étudiants par moyenne décroissante
-    qsort(savg, count, sizeof(StudentCourseAvg), compareCourseAvg);
+    const CourseRoster* roster = &promo->rosters[course_index];
+    int size = (k < roster->size) ? k : roster->size;
+    if (size == 0)
+        return 0;
+
+    // Même sélection que getTopKStudents(), sur la liste des inscrits
+    for (int i = 0; i < size; i++)
+        out[i] = roster->entries[i];
+    for (int i = size / 2 - 1; i >= 0; i--)
+        siftDownWorstEntry(promo, out, size, i);
 
-    // Étape 4 : sélectionner les 3 meilleurs (ou moins)
-    if (count < 3) {
-        *top_count = count;
+    for (int i = size; i < roster->size; i++) {
+        if (rosterRanksBefore(promo, &roster->entries[i], &out[0])) {
+            out[0] = roster->entries[i];
+            siftDownWorstEntry(promo, out, size, 0);
+        }
     }
-    else {
-        *top_count = 3;
+
+    for (int end = size - 1; end > 0; end--) {
+        RosterEntry tmp = out[0];
+        out[0] = out[end];
+        out[end] = tmp;
+        siftDownWorstEntry(promo, out, end, 0);
     }
 
-    Student** top_three = malloc(sizeof(Student*) * (*top_count));
-    if (top_three == NULL) {
-        free(savg);
-        *top_count = 0;
+    *count = size;
+    return 0;
+}
+
+/**
+ * @brief Retourne les 3 meilleurs étudiants d’un cours spécifique.
+ */
+RosterEntry* getTopThreeStudentsCourse(Prom* promo, const char* course_name, int* top_count) {
+    RosterEntry best[3];
+    int count = 0;
+    *top_count = 0;
+
+    if (getTopKStudentsCourse(promo, course_name, 3, best, &count) == -1 || count == 0) {
+        if (promo != NULL && course_name != NULL && promo->num_students > 0)
+            printf("This course doesn't exist\n");
         return NULL;
     }
 
-    for (int i = 0; i < *top_count; i++) {
-        top_three[i] = savg[i].s;
-    }
+    RosterEntry* top_three = malloc(sizeof(RosterEntry) * count);
+    if (top_three == NULL)
+        return NULL;
 
-    free(savg);
+    memcpy(top_three, best, sizeof(RosterEntry) * count);
+    *top_count = count;
     return top_three;
 }
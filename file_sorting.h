@@ -4,8 +4,8 @@
  *
  * Ce module regroupe les fonctions permettant de :
  * - Trier les étudiants d’une promotion selon leur moyenne générale.
- * - Obtenir les 10 meilleurs étudiants de la promotion.
- * - Obtenir les 3 meilleurs étudiants d’un cours donné.
+ * - Obtenir les `k` meilleurs étudiants de la promotion (dont les 10 meilleurs).
+ * - Obtenir les `k` meilleurs étudiants d’un cours donné (dont les 3 meilleurs).
  *
  * Il repose sur la bibliothèque standard C (qsort, memcpy) et les structures définies
  * dans `struct.h`.
@@ -35,11 +35,29 @@
  */
 int compareStudents(const void* a, const void* b);
 
+/**
+ * @brief Sélectionne les `k` meilleurs étudiants d’une promotion, triés par moyenne générale décroissante.
+ *
+ * Un tas de `k` éléments, construit directement dans `out`, garde les meilleurs
+ * rencontrés au cours d’un unique parcours : O(n log k), sans allocation ni copie
+ * de la promotion. À moyenne égale, l’étudiant le plus tôt dans la promotion passe
+ * en premier. Si la promotion tient des classements (`enableLeaderboards()`), le
+ * résultat, identique, est lu en O(k).
+ *
+ * @param promo Pointeur vers la promotion.
+ * @param k     Nombre d’étudiants demandés.
+ * @param out   Tableau d’au moins `k` pointeurs, rempli avec les étudiants classés.
+ * @param count Pointeur vers un entier où sera stocké le nombre d’étudiants retournés (≤ k).
+ * @return 0 si succès, -1 si un argument est invalide.
+ */
+int getTopKStudents(const Prom* promo, int k, Student** out, int* count);
+
 /**
  * @brief Retourne les 10 meilleurs étudiants d’une promotion, triés par moyenne générale décroissante.
  *
  * Si la promotion contient moins de 10 étudiants, tous sont retournés.  
- * La fonction alloue dynamiquement un tableau de pointeurs vers les étudiants triés.
+ * La fonction alloue dynamiquement un tableau de pointeurs vers les étudiants triés
+ * et le remplit avec `getTopKStudents()`.
  *
  * @param promo Pointeur vers la structure `Prom` représentant la promotion.
  * @param count Pointeur vers un entier où sera stocké le nombre d’étudiants retournés.
@@ -49,19 +67,39 @@ int compareStudents(const void* a, const void* b);
  */
 Student** getTopTenStudents(Prom* promo, int* count);
 
+/**
+ * @brief Sélectionne les `k` meilleurs inscrits d’une matière, triés par moyenne décroissante dans la matière.
+ *
+ * Parcourt uniquement la liste des inscrits de la matière (`Prom.rosters`), avec la
+ * même sélection par tas que `getTopKStudents()` : O(inscrits × log k), sans
+ * allocation ni comparaison de chaînes au-delà de la recherche du nom dans le catalogue.
+ * À moyenne égale, l’étudiant le plus tôt dans la promotion passe en premier.
+ * Avec les classements de `enableLeaderboards()`, le résultat est lu en O(k).
+ *
+ * @param promo       Pointeur vers la promotion.
+ * @param course_name Nom de la matière.
+ * @param k           Nombre d’étudiants demandés.
+ * @param out         Tableau d’au moins `k` entrées, rempli avec les inscrits classés
+ *                    (l’étudiant et son inscription à la matière).
+ * @param count       Pointeur vers un entier où sera stocké le nombre d’inscrits retournés (≤ k).
+ * @return 0 si succès, -1 si un argument est invalide ou si la matière n’existe pas.
+ */
+int getTopKStudentsCourse(const Prom* promo, const char* course_name, int k, RosterEntry* out, int* count);
+
 /**
  * @brief Retourne les 3 meilleurs étudiants d’un cours donné.
  *
- * La fonction recherche les étudiants inscrits au cours spécifié, trie leurs moyennes
- * pour ce cours dans l’ordre décroissant, puis renvoie les 3 meilleurs (ou moins s’il y en a moins de 3).
+ * Les 3 meilleurs (ou moins s’il y en a moins de 3) sont sélectionnés par
+ * `getTopKStudentsCourse()`, puis copiés dans un tableau alloué. Chaque entrée donne
+ * l’étudiant et son inscription au cours, d’où se lit sa moyenne dans ce cours.
  *
  * @param promo        Pointeur vers la promotion complète.
  * @param course_name  Nom du cours concerné.
  * @param top_count    Pointeur vers un entier où sera stocké le nombre d’étudiants trouvés (≤ 3).
- * @return Un tableau dynamique de pointeurs vers les meilleurs étudiants du cours, ou NULL si aucun n’est trouvé.
+ * @return Un tableau dynamique des inscriptions des meilleurs étudiants du cours, ou NULL si aucun n’est trouvé.
  *
  * @note Le tableau retourné doit être libéré avec `free()` par l’appelant.
  */
-Student** getTopThreeStudentsCourse(Prom* promo, const char* course_name, int* top_count);
+RosterEntry* getTopThreeStudentsCourse(Prom* promo, const char* course_name, int* top_count);
 
 #endif // TOP_STUDENTS_H
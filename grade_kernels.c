@@ -0,0 +1,351 @@
+/**
+ * @file grade_kernels.c
+ * @brief Versions AVX2, SSE2 et scalaire des noyaux de moyennes, choisies à l’exécution.
+ *
+ * @see grade_kernels.h
+ */
+
+#include <pthread.h>
+#include <string.h>
+#include "./grade_kernels.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define GRADE_KERNELS_HAVE_X86 1
+#endif
+
+/**
+ * @struct GradeKernels
+ * @brief Version des noyaux retenue pour ce processeur.
+ */
+typedef struct GradeKernels {
+    const char* name;
+    int (*sum)(const uint8_t*, int);
+    void (*segments)(const uint8_t*, const int*, int*, size_t);
+    void (*averages)(const int*, const int*, float*, size_t);
+    void (*weighted)(float*, float*, const float*, const float*, const int*, size_t, size_t);
+    void (*general)(float*, const float*, const float*, size_t);
+} GradeKernels;
+
+/** @brief Choix unique de la version des noyaux. */
+static pthread_once_t kernels_once = PTHREAD_ONCE_INIT;
+
+/** @brief Version retenue par `initGradeKernels()`. */
+static GradeKernels kernels;
+
+/* ---------- Version scalaire ---------- */
+
+static int sumScalar(const uint8_t* grades, int size) {
+    int sum = 0;
+    for (int i = 0; i < size; i++)
+        sum += grades[i];
+    return sum;
+}
+
+static void segmentsScalar(const uint8_t* grades, const int* offsets, int* sums, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        sums[i] = sumScalar(grades + offsets[i], offsets[i + 1] - offsets[i]);
+}
+
+static void averagesScalar(const int* sums, const int* offsets, float* averages, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        int count = offsets[i + 1] - offsets[i];
+        averages[i] = count > 0 ? (float)(sums[i] / (10.0 * count)) : 0.0f;
+    }
+}
+
+static void weightedScalar(float* totals, float* coeff_totals, const float* averages,
+                           const float* coeffs, const int* courses, size_t n, size_t i) {
+    for (; i < n; i++) {
+        int c = courses[i];
+        if (c < 0)
+            continue;
+        totals[i] += averages[(size_t)c * n + i] * coeffs[c];
+        coeff_totals[i] += coeffs[c];
+    }
+}
+
+static void generalScalar(float* out, const float* totals, const float* coeff_totals, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (coeff_totals[i] > 0)
+            out[i] = totals[i] / coeff_totals[i];
+    }
+}
+
+#ifdef GRADE_KERNELS_HAVE_X86
+
+/**
+ * @brief 32 octets à 0xFF puis 32 à 0 : lus à partir de `keep_mask + 32 - k`, ils ne
+ *        gardent que les `k` premiers octets d’un vecteur.
+ */
+static const uint8_t keep_mask[64] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+/* ---------- Version SSE2 : 16 notes ou 2 cases par itération ---------- */
+
+__attribute__((target("sse2")))
+static int sumSse2(const uint8_t* grades, int size) {
+    if (size < 16)
+        return sumScalar(grades, size);
+
+    // psadbw contre zéro : somme de 8 octets dans chaque moitié de 64 bits
+    __m128i acc = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(grades + i));
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(v, _mm_setzero_si128()));
+    }
+    int sum = _mm_cvtsi128_si32(acc) + _mm_cvtsi128_si32(_mm_unpackhi_epi64(acc, acc));
+    return sum + sumScalar(grades + i, size - i);
+}
+
+__attribute__((target("sse2")))
+static void segmentsSse2(const uint8_t* grades, const int* offsets, int* sums, size_t n) {
+    // Une case à la fois : psadbw sur 16 notes, la fin de la case masquée. Les octets
+    // lus au-delà de la case appartiennent aux suivantes, jusqu’à offsets[n]
+    const int last = offsets[n];
+    for (size_t i = 0; i < n; i++) {
+        int pos = offsets[i], end = offsets[i + 1];
+        __m128i acc = _mm_setzero_si128();
+        for (; pos + 16 <= end; pos += 16)
+            acc = _mm_add_epi64(acc, _mm_sad_epu8(_mm_loadu_si128((const __m128i*)(grades + pos)), _mm_setzero_si128()));
+        int tail = 0;
+        if (pos < end && pos + 16 <= last) {
+            __m128i v = _mm_and_si128(_mm_loadu_si128((const __m128i*)(grades + pos)),
+                                      _mm_loadu_si128((const __m128i*)(keep_mask + 32 - (end - pos))));
+            acc = _mm_add_epi64(acc, _mm_sad_epu8(v, _mm_setzero_si128()));
+        } else {
+            tail = sumScalar(grades + pos, end - pos);
+        }
+        sums[i] = _mm_cvtsi128_si32(acc) + _mm_cvtsi128_si32(_mm_unpackhi_epi64(acc, acc)) + tail;
+    }
+}
+
+__attribute__((target("sse2")))
+static void averagesSse2(const int* sums, const int* offsets, float* averages, size_t n) {
+    const __m128d ten = _mm_set1_pd(10.0);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128i count = _mm_sub_epi32(_mm_loadl_epi64((const __m128i*)(offsets + i + 1)),
+                                      _mm_loadl_epi64((const __m128i*)(offsets + i)));
+        __m128d den = _mm_mul_pd(_mm_cvtepi32_pd(count), ten);
+        __m128d q = _mm_div_pd(_mm_cvtepi32_pd(_mm_loadl_epi64((const __m128i*)(sums + i))), den);
+        __m128 empty = _mm_castsi128_ps(_mm_cmpeq_epi32(count, _mm_setzero_si128()));
+        _mm_storel_pi((__m64*)(averages + i), _mm_andnot_ps(empty, _mm_cvtpd_ps(q)));
+    }
+    averagesScalar(sums + i, offsets + i, averages + i, n - i);
+}
+
+__attribute__((target("sse2")))
+static void weightedSse2(float* totals, float* coeff_totals, const float* averages,
+                         const float* coeffs, const int* courses, size_t n, size_t i) {
+    // Pas de lecture indexée en SSE2 : les 4 moyennes et coefficients sont chargés un à un
+    for (; i + 4 <= n; i += 4) {
+        float avg[4], coeff[4];
+        for (int k = 0; k < 4; k++) {
+            int c = courses[i + k];
+            avg[k] = c < 0 ? 0.0f : averages[(size_t)c * n + i + k];
+            coeff[k] = c < 0 ? 0.0f : coeffs[c];
+        }
+        __m128 has = _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_loadu_si128((const __m128i*)(courses + i)),
+                                                      _mm_set1_epi32(-1)));
+        __m128 t = _mm_loadu_ps(totals + i);
+        __m128 s = _mm_loadu_ps(coeff_totals + i);
+        __m128 w = _mm_add_ps(t, _mm_mul_ps(_mm_loadu_ps(avg), _mm_loadu_ps(coeff)));
+        _mm_storeu_ps(totals + i, _mm_or_ps(_mm_and_ps(has, w), _mm_andnot_ps(has, t)));
+        _mm_storeu_ps(coeff_totals + i, _mm_or_ps(_mm_and_ps(has, _mm_add_ps(s, _mm_loadu_ps(coeff))),
+                                                  _mm_andnot_ps(has, s)));
+    }
+    weightedScalar(totals, coeff_totals, averages, coeffs, courses, n, i);
+}
+
+__attribute__((target("sse2")))
+static void generalSse2(float* out, const float* totals, const float* coeff_totals, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 s = _mm_loadu_ps(coeff_totals + i);
+        __m128 mask = _mm_cmpgt_ps(s, _mm_setzero_ps());
+        __m128 q = _mm_div_ps(_mm_loadu_ps(totals + i), s);
+        _mm_storeu_ps(out + i, _mm_or_ps(_mm_and_ps(mask, q), _mm_andnot_ps(mask, _mm_loadu_ps(out + i))));
+    }
+    generalScalar(out + i, totals + i, coeff_totals + i, n - i);
+}
+
+/* ---------- Version AVX2 : 32 notes ou 4 cases par itération ---------- */
+
+__attribute__((target("avx2")))
+static int sumAvx2(const uint8_t* grades, int size) {
+    if (size < 32)
+        return sumScalar(grades, size);
+
+    __m256i acc = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(grades + i));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(v, _mm256_setzero_si256()));
+    }
+    __m128i half = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    int sum = _mm_cvtsi128_si32(half) + _mm_cvtsi128_si32(_mm_unpackhi_epi64(half, half));
+    return sum + sumScalar(grades + i, size - i);
+}
+
+__attribute__((target("avx2")))
+static void segmentsAvx2(const uint8_t* grades, const int* offsets, int* sums, size_t n) {
+    // Comme segmentsSse2(), sur 32 notes
+    const int last = offsets[n];
+    for (size_t i = 0; i < n; i++) {
+        int pos = offsets[i], end = offsets[i + 1];
+        __m256i acc = _mm256_setzero_si256();
+        for (; pos + 32 <= end; pos += 32)
+            acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_loadu_si256((const __m256i*)(grades + pos)),
+                                                        _mm256_setzero_si256()));
+        int tail = 0;
+        if (pos < end && pos + 32 <= last) {
+            __m256i v = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(grades + pos)),
+                                         _mm256_loadu_si256((const __m256i*)(keep_mask + 32 - (end - pos))));
+            acc = _mm256_add_epi64(acc, _mm256_sad_epu8(v, _mm256_setzero_si256()));
+        } else {
+            tail = sumScalar(grades + pos, end - pos);
+        }
+        __m128i half = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+        sums[i] = _mm_cvtsi128_si32(half) + _mm_cvtsi128_si32(_mm_unpackhi_epi64(half, half)) + tail;
+    }
+}
+
+__attribute__((target("avx2")))
+static void averagesAvx2(const int* sums, const int* offsets, float* averages, size_t n) {
+    const __m256d ten = _mm256_set1_pd(10.0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i count = _mm_sub_epi32(_mm_loadu_si128((const __m128i*)(offsets + i + 1)),
+                                      _mm_loadu_si128((const __m128i*)(offsets + i)));
+        __m256d den = _mm256_mul_pd(_mm256_cvtepi32_pd(count), ten);
+        __m256d q = _mm256_div_pd(_mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i*)(sums + i))), den);
+        __m128 empty = _mm_castsi128_ps(_mm_cmpeq_epi32(count, _mm_setzero_si128()));
+        _mm_storeu_ps(averages + i, _mm_andnot_ps(empty, _mm256_cvtpd_ps(q)));
+    }
+    averagesScalar(sums + i, offsets + i, averages + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static void weightedAvx2(float* totals, float* coeff_totals, const float* averages,
+                         const float* coeffs, const int* courses, size_t n, size_t i) {
+    const __m256i stride = _mm256_set1_epi32((int)n);
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    for (; i + 8 <= n; i += 8) {
+        __m256i c = _mm256_loadu_si256((const __m256i*)(courses + i));
+        __m256 has = _mm256_castsi256_ps(_mm256_cmpgt_epi32(c, _mm256_set1_epi32(-1)));
+        __m256i cell = _mm256_add_epi32(_mm256_mullo_epi32(c, stride),
+                                        _mm256_add_epi32(_mm256_set1_epi32((int)i), lanes));
+        __m256 coeff = _mm256_mask_i32gather_ps(_mm256_setzero_ps(), coeffs, c, has, 4);
+        __m256 avg = _mm256_mask_i32gather_ps(_mm256_setzero_ps(), averages, cell, has, 4);
+        __m256 t = _mm256_loadu_ps(totals + i);
+        __m256 s = _mm256_loadu_ps(coeff_totals + i);
+        _mm256_storeu_ps(totals + i, _mm256_blendv_ps(t, _mm256_add_ps(t, _mm256_mul_ps(avg, coeff)), has));
+        _mm256_storeu_ps(coeff_totals + i, _mm256_blendv_ps(s, _mm256_add_ps(s, coeff), has));
+    }
+    weightedScalar(totals, coeff_totals, averages, coeffs, courses, n, i);
+}
+
+__attribute__((target("avx2")))
+static void generalAvx2(float* out, const float* totals, const float* coeff_totals, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 s = _mm256_loadu_ps(coeff_totals + i);
+        __m256 mask = _mm256_cmp_ps(s, _mm256_setzero_ps(), _CMP_GT_OQ);
+        __m256 q = _mm256_div_ps(_mm256_loadu_ps(totals + i), s);
+        _mm256_storeu_ps(out + i, _mm256_blendv_ps(_mm256_loadu_ps(out + i), q, mask));
+    }
+    generalScalar(out + i, totals + i, coeff_totals + i, n - i);
+}
+
+#endif
+
+/**
+ * @brief Choisit la version des noyaux d’après les instructions du processeur.
+ */
+static void initGradeKernels(void) {
+    kernels = (GradeKernels){ "scalar", sumScalar, segmentsScalar, averagesScalar, weightedScalar, generalScalar };
+#ifdef GRADE_KERNELS_HAVE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        kernels = (GradeKernels){ "avx2", sumAvx2, segmentsAvx2, averagesAvx2, weightedAvx2, generalAvx2 };
+    else if (__builtin_cpu_supports("sse2"))
+        kernels = (GradeKernels){ "sse2", sumSse2, segmentsSse2, averagesSse2, weightedSse2, generalSse2 };
+#endif
+}
+
+/**
+ * @brief Somme de notes en dixièmes de point.
+ */
+int sumGradeTenths(const uint8_t* grades, int size) {
+    pthread_once(&kernels_once, initGradeKernels);
+    return kernels.sum(grades, size);
+}
+
+/**
+ * @brief Sommes des notes de cases consécutives stockées au format CSR.
+ */
+void sumGradeSegments(const uint8_t* grades, const int* offsets, int* sums, size_t n) {
+    pthread_once(&kernels_once, initGradeKernels);
+    kernels.segments(grades, offsets, sums, n);
+}
+
+/**
+ * @brief Moyennes d’une suite de cases à partir de leurs sommes et de décalages CSR.
+ */
+void averagesFromSums(const int* sums, const int* offsets, float* averages, size_t n) {
+    pthread_once(&kernels_once, initGradeKernels);
+    kernels.averages(sums, offsets, averages, n);
+}
+
+/**
+ * @brief Ajoute aux totaux de chaque étudiant la moyenne pondérée de son cours de rang donné.
+ */
+void addWeightedRank(float* totals, float* coeff_totals, const float* averages,
+                     const float* coeffs, const int* courses, size_t n) {
+    pthread_once(&kernels_once, initGradeKernels);
+    kernels.weighted(totals, coeff_totals, averages, coeffs, courses, n, 0);
+}
+
+/**
+ * @brief Moyennes générales à partir des totaux pondérés.
+ */
+void weightedAverages(float* out, const float* totals, const float* coeff_totals, size_t n) {
+    pthread_once(&kernels_once, initGradeKernels);
+    kernels.general(out, totals, coeff_totals, n);
+}
+
+/**
+ * @brief Impose une version des noyaux, si le processeur la permet.
+ */
+int selectGradeKernels(const char* name) {
+    pthread_once(&kernels_once, initGradeKernels);
+    if (name == NULL)
+        return -1;
+    if (strcmp(name, "scalar") == 0) {
+        kernels = (GradeKernels){ "scalar", sumScalar, segmentsScalar, averagesScalar, weightedScalar, generalScalar };
+        return 0;
+    }
+#ifdef GRADE_KERNELS_HAVE_X86
+    if (strcmp(name, "avx2") == 0 && __builtin_cpu_supports("avx2")) {
+        kernels = (GradeKernels){ "avx2", sumAvx2, segmentsAvx2, averagesAvx2, weightedAvx2, generalAvx2 };
+        return 0;
+    }
+    if (strcmp(name, "sse2") == 0 && __builtin_cpu_supports("sse2")) {
+        kernels = (GradeKernels){ "sse2", sumSse2, segmentsSse2, averagesSse2, weightedSse2, generalSse2 };
+        return 0;
+    }
+#endif
+    return -1;
+}
+
+/**
+ * @brief Nom de la version des noyaux choisie pour ce processeur.
+ */
+const char* gradeKernelsName(void) {
+    pthread_once(&kernels_once, initGradeKernels);
+    return kernels.name;
+}
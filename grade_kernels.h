@@ -0,0 +1,109 @@
+/**
+ * @file grade_kernels.h
+ * @brief Noyaux vectoriels (AVX2, SSE2) des sommes de notes et des moyennes, avec repli scalaire.
+ *
+ * La version utilisée est choisie une seule fois à l’exécution, d’après les
+ * instructions proposées par le processeur (`cpuid`) : AVX2, sinon SSE2, sinon une
+ * boucle scalaire. Toutes donnent exactement le même résultat : les sommes sont
+ * entières, chaque moyenne de cours est calculée en double avec les mêmes opérations
+ * que `gradesAverage()` et chaque moyenne générale en float avec celles de
+ * `updateGeneralAverage()`.
+ *
+ * Les noyaux travaillent sur des tableaux denses, en particulier ceux de
+ * `PromColumns` (notes au format CSR, matrice des moyennes cours par cours).
+ *
+ * @see prom_columns.h
+ */
+
+#ifndef GRADE_KERNELS_H
+#define GRADE_KERNELS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Somme de notes en dixièmes de point.
+ *
+ * @param grades Notes (un octet chacune).
+ * @param size   Nombre de notes.
+ * @return La somme, en dixièmes.
+ */
+int sumGradeTenths(const uint8_t* grades, int size);
+
+/**
+ * @brief Sommes des notes de cases consécutives stockées au format CSR.
+ *
+ * Chaque somme est calculée par `psadbw` sur 16 ou 32 notes à la fois, la fin de la
+ * case masquée ; les notes lues au-delà d’une case restent en deçà de `offsets[n]`.
+ *
+ * @param grades  Toutes les notes, en dixièmes.
+ * @param offsets Décalages CSR, `n + 1` entrées : les notes de la case `i` sont
+ *                `grades[offsets[i]]` à `grades[offsets[i + 1] - 1]`.
+ * @param sums    Somme des notes de chaque case, `n` entrées.
+ * @param n       Nombre de cases.
+ */
+void sumGradeSegments(const uint8_t* grades, const int* offsets, int* sums, size_t n);
+
+/**
+ * @brief Moyennes d’une suite de cases à partir de leurs sommes et de décalages CSR.
+ *
+ * Pour chaque case `i`, avec `count = offsets[i + 1] - offsets[i]` notes :
+ * `averages[i] = (float)(sums[i] / (10.0 * count))`, ou 0 si la case n’a pas de note.
+ *
+ * @param sums     Somme des notes de chaque case, en dixièmes.
+ * @param offsets  Décalages CSR, `n + 1` entrées.
+ * @param averages Moyennes calculées, `n` entrées.
+ * @param n        Nombre de cases.
+ */
+void averagesFromSums(const int* sums, const int* offsets, float* averages, size_t n);
+
+/**
+ * @brief Ajoute aux totaux de chaque étudiant la moyenne pondérée de son cours de rang donné.
+ *
+ * Pour chaque étudiant `i` tel que `c = courses[i] >= 0` :
+ * `totals[i] += averages[c * n + i] * coeffs[c]` et `coeff_totals[i] += coeffs[c]`,
+ * produit et sommes arrondis en `float`. Appelée une fois par rang d’inscription,
+ * elle refait exactement les opérations de `updateGeneralAverage()`.
+ *
+ * @param totals       Sommes pondérées des étudiants.
+ * @param coeff_totals Sommes des coefficients des étudiants.
+ * @param averages     Matrice des moyennes, cours par cours (`n` entrées par cours).
+ * @param coeffs       Coefficient de chaque cours.
+ * @param courses      Cours de rang donné de chaque étudiant, ou -1 s’il n’en a pas.
+ * @param n            Nombre d’étudiants (`n` × nombre de cours < 2³¹).
+ */
+void addWeightedRank(float* totals, float* coeff_totals, const float* averages,
+                     const float* coeffs, const int* courses, size_t n);
+
+/**
+ * @brief Moyennes générales à partir des totaux pondérés.
+ *
+ * `out[i] = totals[i] / coeff_totals[i]` en `float` ; `out[i]` est gardé si la somme
+ * des coefficients est nulle, comme dans `updateGeneralAverage()`.
+ *
+ * @param out          Moyennes générales calculées.
+ * @param totals       Sommes pondérées.
+ * @param coeff_totals Sommes des coefficients.
+ * @param n            Nombre d’étudiants.
+ */
+void weightedAverages(float* out, const float* totals, const float* coeff_totals, size_t n);
+
+/**
+ * @brief Impose une version des noyaux, si le processeur la permet.
+ *
+ * Sert aux tests, qui comparent chaque version à la version scalaire. À appeler
+ * quand aucun autre thread n’utilise les noyaux.
+ *
+ * @param name "avx2", "sse2" ou "scalar".
+ * @return 0 si la version est retenue, -1 si elle est inconnue ou non prise en charge.
+ */
+int selectGradeKernels(const char* name);
+
+/**
+ * @brief Nom de la version des noyaux choisie pour ce processeur.
+ *
+ * @return "avx2", "sse2" ou "scalar".
+ */
+const char* gradeKernelsName(void);
+
+#endif // GRADE_KERNELS_H
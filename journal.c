@@ -0,0 +1,591 @@
+/**
+ * @file journal.c
+ * @brief Ajout, rejeu et compactage du journal des modifications d’une promotion.
+ *
+ * @see journal.h
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "./journal.h"
+#include "./snapshot.h"
+#include "./crc32c.h"
+#include "./struct_functions.h"
+#include "./file_gestion.h"
+
+/** @brief Taille maximale d’une charge utile acceptée au rejeu. */
+#define JOURNAL_MAX_PAYLOAD (1 << 20)
+
+/**
+ * @brief Indique si la machine range les entiers en little-endian (ordre du format).
+ */
+static int hostIsLittleEndian(void) {
+    const uint16_t probe = 1;
+    return *(const unsigned char*)&probe == 1;
+}
+
+/**
+ * @brief Lit la génération enregistrée dans un snapshot.
+ *
+ * @return 0 si succès, -1 si le snapshot ne peut pas être ouvert.
+ */
+static int readSnapshotGeneration(const char* snapshot_file, uint64_t* generation) {
+    Snapshot* snap = openSnapshot(snapshot_file);
+    if (snap == NULL)
+        return -1;
+    *generation = snap->journal_generation;
+    closeSnapshot(snap);
+    return 0;
+}
+
+/**
+ * @brief Lit et vérifie l’en-tête d’un journal ouvert en lecture.
+ *
+ * @return 1 si l’en-tête est valide, 0 si le fichier est vide, -1 s’il n’est pas un journal.
+ */
+static int readJournalHeader(FILE* f, uint64_t* generation) {
+    unsigned char header[JOURNAL_HEADER_SIZE];
+    size_t got = fread(header, 1, sizeof(header), f);
+    if (got == 0)
+        return 0;
+
+    uint32_t version;
+    memcpy(&version, header + 8, sizeof(uint32_t));
+    if (got != sizeof(header) || memcmp(header, JOURNAL_MAGIC, 8) != 0 || version != JOURNAL_VERSION)
+        return -1;
+
+    memcpy(generation, header + 16, sizeof(uint64_t));
+    return 1;
+}
+
+/**
+ * @brief Lit la suite d’un journal ouvert en lecture, juste après l’en-tête, en un seul bloc.
+ *
+ * @return Le contenu alloué (à libérer), ou NULL en cas d’erreur.
+ */
+static unsigned char* readJournalEntries(FILE* f, size_t* size) {
+    long start = ftell(f);
+    long end = (fseek(f, 0, SEEK_END) == 0) ? ftell(f) : -1;
+    if (start < 0 || end < start || fseek(f, start, SEEK_SET) != 0)
+        return NULL;
+
+    *size = (size_t)(end - start);
+    unsigned char* data = malloc(*size > 0 ? *size : 1);
+    if (data != NULL && fread(data, 1, *size, f) != *size) {
+        free(data);
+        return NULL;
+    }
+    return data;
+}
+
+/**
+ * @brief Vérifie l’entrée qui commence à `pos` : en-tête complet, taille plausible et CRC32C.
+ *
+ * @return 1 si l’entrée est valide, 0 si elle est incomplète, -1 si sa somme de contrôle est fausse.
+ */
+static int checkEntry(const unsigned char* data, size_t size, size_t pos, JournalEntryHeader* header) {
+    if (size - pos < sizeof(JournalEntryHeader))
+        return 0;
+    memcpy(header, data + pos, sizeof(*header));
+    if (header->length > JOURNAL_MAX_PAYLOAD || header->length > size - pos - sizeof(*header))
+        return 0;
+    return crc32c(0, data + pos + sizeof(*header), header->length) == header->crc ? 1 : -1;
+}
+
+/**
+ * @brief Coupe la dernière entrée d’un journal si une écriture interrompue l’a laissée incomplète.
+ *
+ * Les entrées ajoutées ensuite seraient écrites derrière elle, et le rejeu, qui s’arrête
+ * à la première entrée invalide, les perdrait. Seule la dernière entrée est coupée :
+ * en-tête ou charge utile dépassant la fin du fichier, ou somme de contrôle fausse sur
+ * une entrée qui se termine exactement en fin de fichier. Une entrée altérée suivie
+ * d’autres octets est une corruption : le journal est laissé tel quel.
+ *
+ * @return 0 si succès (journal intact ou coupé), -1 si le journal est corrompu ou en
+ *         cas d’erreur de lecture ou d’écriture.
+ */
+static int truncateJournalTail(const char* journal_file) {
+    FILE* f = fopen(journal_file, "rb");
+    if (f == NULL)
+        return -1;
+
+    uint64_t generation;
+    size_t size = 0;
+    unsigned char* data = (readJournalHeader(f, &generation) == 1) ? readJournalEntries(f, &size) : NULL;
+    fclose(f);
+    if (data == NULL) {
+        perror("Erreur lors de la lecture du journal");
+        return -1;
+    }
+
+    size_t pos = 0;
+    JournalEntryHeader header;
+    int check;
+    while ((check = checkEntry(data, size, pos, &header)) == 1)
+        pos += sizeof(header) + header.length;
+    free(data);
+
+    if (pos == size)
+        return 0;
+    int torn = (check == 0 && (size - pos < sizeof(header) || header.length <= JOURNAL_MAX_PAYLOAD)) ||
+               (check < 0 && header.length == size - pos - sizeof(header));
+    if (!torn) {
+        fprintf(stderr, "Erreur : entrée corrompue à l'octet %zu du journal %s, suivie d'autres entrées.\n",
+                JOURNAL_HEADER_SIZE + pos, journal_file);
+        return -1;
+    }
+    fprintf(stderr, "⚠️ Fin du journal %s incomplète ou altérée : %zu octets supprimés.\n", journal_file, size - pos);
+    if (truncate(journal_file, (off_t)(JOURNAL_HEADER_SIZE + pos)) != 0) {
+        perror("Erreur lors de la réparation du journal");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Remplace un journal par un journal vide de la génération donnée.
+ *
+ * Le nouveau journal est écrit dans un fichier temporaire puis renommé.
+ *
+ * @return 0 si succès, -1 sinon.
+ */
+static int resetJournal(const char* journal_file, uint64_t generation) {
+    size_t len = strlen(journal_file);
+    char* tmp = malloc(len + 5);
+    if (tmp == NULL)
+        return -1;
+    memcpy(tmp, journal_file, len);
+    memcpy(tmp + len, ".tmp", 5);
+
+    unsigned char header[JOURNAL_HEADER_SIZE] = {0};
+    uint32_t version = JOURNAL_VERSION;
+    memcpy(header, JOURNAL_MAGIC, 8);
+    memcpy(header + 8, &version, sizeof(uint32_t));
+    memcpy(header + 16, &generation, sizeof(uint64_t));
+
+    FILE* f = fopen(tmp, "wb");
+    int ok = f != NULL && fwrite(header, 1, sizeof(header), f) == sizeof(header);
+    if (f != NULL) {
+        ok = ok && fflush(f) == 0 && fsync(fileno(f)) == 0;
+        ok = (fclose(f) == 0) && ok;
+    }
+    ok = ok && rename(tmp, journal_file) == 0;
+    if (!ok) {
+        perror("Erreur lors de l'écriture du journal");
+        remove(tmp);
+    }
+    free(tmp);
+    return ok ? 0 : -1;
+}
+
+/**
+ * @brief Ouvre en ajout le journal associé à un snapshot.
+ */
+Journal* openJournal(const char* snapshot_file, const char* journal_file) {
+    if (snapshot_file == NULL || journal_file == NULL) {
+        fprintf(stderr, "Erreur : arguments invalides.\n");
+        return NULL;
+    }
+    if (!hostIsLittleEndian()) {
+        fprintf(stderr, "Erreur : format du journal non pris en charge sur cette machine.\n");
+        return NULL;
+    }
+
+    uint64_t snap_generation;
+    if (readSnapshotGeneration(snapshot_file, &snap_generation) != 0)
+        return NULL;
+
+    int status = 0;
+    uint64_t generation = 0;
+    FILE* f = fopen(journal_file, "rb");
+    if (f != NULL) {
+        status = readJournalHeader(f, &generation);
+        fclose(f);
+    }
+    if (status < 0) {
+        fprintf(stderr, "Erreur : %s n'est pas un journal valide.\n", journal_file);
+        return NULL;
+    }
+    if (status == 1 && generation > snap_generation) {
+        fprintf(stderr, "Erreur : le journal %s est plus récent que le snapshot %s.\n", journal_file, snapshot_file);
+        return NULL;
+    }
+    // Journal absent, vide ou déjà intégré au snapshot : on repart d’un journal vide
+    if ((status == 0 || generation < snap_generation) && resetJournal(journal_file, snap_generation) != 0)
+        return NULL;
+    // Journal en cours : les nouvelles entrées doivent suivre la dernière entrée valide
+    if (status == 1 && generation == snap_generation && truncateJournalTail(journal_file) != 0)
+        return NULL;
+
+    Journal* j = malloc(sizeof(Journal));
+    if (j == NULL)
+        return NULL;
+    j->file = fopen(journal_file, "ab");
+    if (j->file == NULL) {
+        perror("Erreur lors de l'ouverture du journal");
+        free(j);
+        return NULL;
+    }
+    j->num_entries = 0;
+    return j;
+}
+
+/**
+ * @brief Force l’écriture sur disque des entrées déjà ajoutées.
+ */
+int syncJournal(Journal* j) {
+    if (j == NULL)
+        return -1;
+    return (fflush(j->file) == 0 && fsync(fileno(j->file)) == 0) ? 0 : -1;
+}
+
+/**
+ * @brief Ferme un journal.
+ */
+void closeJournal(Journal* j) {
+    if (j == NULL)
+        return;
+    fclose(j->file);
+    free(j);
+}
+
+/**
+ * @brief Ajoute une entrée (en-tête et charge utile) à la fin du journal, en une seule écriture.
+ *
+ * @return 0 si succès, -1 sinon.
+ */
+static int appendEntry(Journal* j, uint16_t type, const unsigned char* payload, uint32_t length) {
+    unsigned char* entry = malloc(sizeof(JournalEntryHeader) + length);
+    if (entry == NULL)
+        return -1;
+
+    JournalEntryHeader header = { length, type, 0, crc32c(0, payload, length) };
+    memcpy(entry, &header, sizeof(header));
+    memcpy(entry + sizeof(header), payload, length);
+
+    size_t size = sizeof(header) + length;
+    int ok = fwrite(entry, 1, size, j->file) == size && fflush(j->file) == 0;
+    free(entry);
+    if (!ok) {
+        perror("Erreur lors de l'écriture du journal");
+        return -1;
+    }
+    j->num_entries++;
+    return 0;
+}
+
+/**
+ * @brief Applique une note : l’étudiant et la matière doivent exister.
+ */
+static int applyGrade(Prom* promo, int student_id, const char* name, size_t name_len, float grade) {
+    Student* s = findStudentById(promo, student_id);
+    int course = findCourseByNameN(promo, name, name_len);
+    if (s == NULL || course < 0)
+        return -1;
+    if (addGradeToStudent(promo, s, course, grade) != 0)
+        return -1;
+    return 0;
+}
+
+/**
+ * @brief Applique l’ajout d’un étudiant : son numéro ne doit pas déjà exister.
+ */
+static int applyStudent(Prom* promo, int student_id, const char* first_name, size_t first_len,
+                        const char* last_name, size_t last_len, int age) {
+    if (findStudentById(promo, student_id) != NULL)
+        return -1;
+    Student* s = createStudentN(promo->arena, student_id, first_name, first_len, last_name, last_len, age);
+    if (s == NULL)
+        return -1;
+    if (addStudentToProm(promo, s) != 0) {
+        if (promo->arena == NULL)
+            destroyStudent(s);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Applique un coefficient, en créant la matière si elle n’existe pas.
+ */
+static int applyCoeff(Prom* promo, const char* name, size_t name_len, float coeff) {
+    int course = findCourseByNameN(promo, name, name_len);
+    if (course < 0)
+        return addCourseToPromN(promo, name, name_len, coeff) < 0 ? -1 : 0;
+    return setCourseCoeff(promo, course, coeff);
+}
+
+/**
+ * @brief Applique une entrée lue dans le journal.
+ *
+ * @return 0 si l’entrée est appliquée, -1 si elle est invalide, 1 si son type est inconnu.
+ */
+static int applyEntry(Prom* promo, uint16_t type, const unsigned char* payload, uint32_t length) {
+    int32_t id, age;
+    uint32_t len1, len2;
+    float value;
+
+    switch (type) {
+        case JOURNAL_ENTRY_GRADE:
+            if (length < 12)
+                return -1;
+            memcpy(&id, payload, 4);
+            memcpy(&value, payload + 4, 4);
+            memcpy(&len1, payload + 8, 4);
+            if (len1 != length - 12)
+                return -1;
+            return applyGrade(promo, id, (const char*)payload + 12, len1, value);
+
+        case JOURNAL_ENTRY_STUDENT:
+            if (length < 16)
+                return -1;
+            memcpy(&id, payload, 4);
+            memcpy(&age, payload + 4, 4);
+            memcpy(&len1, payload + 8, 4);
+            memcpy(&len2, payload + 12, 4);
+            if (len1 > length - 16 || len2 != length - 16 - len1)
+                return -1;
+            return applyStudent(promo, id, (const char*)payload + 16, len1,
+                                (const char*)payload + 16 + len1, len2, age);
+
+        case JOURNAL_ENTRY_COEFF:
+            if (length < 8)
+                return -1;
+            memcpy(&value, payload, 4);
+            memcpy(&len1, payload + 4, 4);
+            if (len1 != length - 8 || len1 == 0)
+                return -1;
+            return applyCoeff(promo, (const char*)payload + 8, len1, value);
+
+        default:
+            return 1;
+    }
+}
+
+/**
+ * @brief Écrit une entrée dans le journal, puis l’applique à la promotion (écriture anticipée).
+ *
+ * L’entrée a été vérifiée par l’appelant : seule une erreur d’allocation peut encore
+ * empêcher de l’appliquer. Dans ce cas, elle est retirée du journal, qui retrouve sa
+ * taille d’avant l’appel : la promotion et le journal restent d’accord.
+ *
+ * @return 0 si l’entrée est journalisée et appliquée, -1 sinon (ni l’un ni l’autre).
+ */
+static int logAndApply(Journal* j, Prom* promo, uint16_t type, const unsigned char* payload, uint32_t length) {
+    struct stat st;
+    if (fflush(j->file) != 0 || fstat(fileno(j->file), &st) != 0) {
+        perror("Erreur lors de l'écriture du journal");
+        return -1;
+    }
+    if (appendEntry(j, type, payload, length) != 0)
+        return -1;
+    if (applyEntry(promo, type, payload, length) == 0)
+        return 0;
+
+    if (ftruncate(fileno(j->file), st.st_size) != 0)
+        perror("Erreur lors de l'annulation d'une entrée du journal");
+    else
+        j->num_entries--;
+    return -1;
+}
+
+/**
+ * @brief Ajoute une note à la promotion et l’enregistre dans le journal.
+ */
+int journalAddGrade(Journal* j, Prom* promo, int student_id, const char* course_name, float grade) {
+    if (j == NULL || promo == NULL || course_name == NULL)
+        return -1;
+
+    uint32_t name_len = (uint32_t)strlen(course_name);
+    if (findStudentById(promo, student_id) == NULL || findCourseByNameN(promo, course_name, name_len) < 0 ||
+        gradeToTenths(grade) == -1)
+        return -1;
+
+    unsigned char* payload = malloc(12 + (size_t)name_len);
+    if (payload == NULL)
+        return -1;
+    int32_t id = student_id;
+    memcpy(payload, &id, 4);
+    memcpy(payload + 4, &grade, 4);
+    memcpy(payload + 8, &name_len, 4);
+    memcpy(payload + 12, course_name, name_len);
+    int status = logAndApply(j, promo, JOURNAL_ENTRY_GRADE, payload, 12 + name_len);
+    free(payload);
+    return status;
+}
+
+/**
+ * @brief Ajoute un étudiant à la promotion et l’enregistre dans le journal.
+ */
+int journalAddStudent(Journal* j, Prom* promo, int student_id, const char* first_name, const char* last_name, int age) {
+    if (j == NULL || promo == NULL || first_name == NULL || last_name == NULL)
+        return -1;
+    if (findStudentById(promo, student_id) != NULL)
+        return -1;
+
+    uint32_t first_len = (uint32_t)strlen(first_name);
+    uint32_t last_len = (uint32_t)strlen(last_name);
+    uint32_t length = 16 + first_len + last_len;
+    unsigned char* payload = malloc(length);
+    if (payload == NULL)
+        return -1;
+    int32_t id = student_id, age32 = age;
+    memcpy(payload, &id, 4);
+    memcpy(payload + 4, &age32, 4);
+    memcpy(payload + 8, &first_len, 4);
+    memcpy(payload + 12, &last_len, 4);
+    memcpy(payload + 16, first_name, first_len);
+    memcpy(payload + 16 + first_len, last_name, last_len);
+    int status = logAndApply(j, promo, JOURNAL_ENTRY_STUDENT, payload, length);
+    free(payload);
+    return status;
+}
+
+/**
+ * @brief Fixe le coefficient d’une matière et l’enregistre dans le journal.
+ */
+int journalSetCoeff(Journal* j, Prom* promo, const char* course_name, float coeff) {
+    if (j == NULL || promo == NULL || course_name == NULL)
+        return -1;
+
+    // Un nom vide serait refusé au rejeu
+    uint32_t name_len = (uint32_t)strlen(course_name);
+    if (name_len == 0)
+        return -1;
+
+    unsigned char* payload = malloc(8 + (size_t)name_len);
+    if (payload == NULL)
+        return -1;
+    memcpy(payload, &coeff, 4);
+    memcpy(payload + 4, &name_len, 4);
+    memcpy(payload + 8, course_name, name_len);
+    int status = logAndApply(j, promo, JOURNAL_ENTRY_COEFF, payload, 8 + name_len);
+    free(payload);
+    return status;
+}
+
+/**
+ * @brief Rejoue un journal sur une promotion.
+ */
+int replayJournal(const char* filename, uint64_t generation, Prom* promo) {
+    if (filename == NULL || promo == NULL)
+        return -1;
+
+    FILE* f = fopen(filename, "rb");
+    if (f == NULL)
+        return 0;   // pas encore de journal
+
+    uint64_t journal_generation = 0;
+    int status = readJournalHeader(f, &journal_generation);
+    if (status < 0 || !hostIsLittleEndian()) {
+        fprintf(stderr, "Erreur : %s n'est pas un journal valide.\n", filename);
+        fclose(f);
+        return -1;
+    }
+    if (status == 0 || journal_generation != generation) {
+        fclose(f);
+        return 0;   // journal vide, ou déjà intégré au snapshot
+    }
+
+    // Lecture du reste du fichier en un seul bloc
+    size_t size = 0;
+    unsigned char* data = readJournalEntries(f, &size);
+    fclose(f);
+    if (data == NULL) {
+        perror("Erreur lors de la lecture du journal");
+        return -1;
+    }
+
+    int applied = 0, index = 0;
+    size_t pos = 0;
+    JournalEntryHeader header;
+    int check;
+    while ((check = checkEntry(data, size, pos, &header)) != 0) {
+        const unsigned char* payload = data + pos + sizeof(header);
+        pos += sizeof(header) + header.length;
+        index++;
+
+        if (check < 0) {
+            // Dernière entrée : écriture interrompue ; sinon, le reste du journal n’est plus fiable
+            if (pos < size)
+                fprintf(stderr, "⚠️ Entrée %d du journal %s corrompue : rejeu arrêté.\n", index, filename);
+            break;
+        }
+
+        int result = applyEntry(promo, header.type, payload, header.length);
+        if (result == 0)
+            applied++;
+        else if (result < 0)
+            fprintf(stderr, "⚠️ Entrée %d du journal %s ignorée : invalide ou inapplicable.\n", index, filename);
+    }
+
+    free(data);
+    return applied;
+}
+
+/**
+ * @brief Restaure une promotion à partir d’un snapshot et de son journal.
+ */
+Prom* loadPromotionWithJournal(const char* snapshot_file, const char* journal_file, int flags) {
+    if (snapshot_file == NULL || journal_file == NULL)
+        return NULL;
+
+    Snapshot* snap = openSnapshot(snapshot_file);
+    if (snap == NULL)
+        return NULL;
+    uint64_t generation = snap->journal_generation;
+    Prom* promo = loadPromotionFromSnapshot(snap, flags);
+    closeSnapshot(snap);
+    if (promo == NULL)
+        return NULL;
+
+    if (replayJournal(journal_file, generation, promo) < 0) {
+        destroyProm(promo);
+        return NULL;
+    }
+    return promo;
+}
+
+/**
+ * @brief Intègre le journal dans un nouveau snapshot puis vide le journal.
+ */
+int compactJournal(const char* snapshot_file, const char* journal_file) {
+    if (snapshot_file == NULL || journal_file == NULL)
+        return -1;
+
+    uint64_t generation;
+    if (readSnapshotGeneration(snapshot_file, &generation) != 0)
+        return -1;
+    Prom* promo = loadPromotionWithJournal(snapshot_file, journal_file, LOAD_ARENA);
+    if (promo == NULL)
+        return -1;
+
+    size_t len = strlen(snapshot_file);
+    char* tmp = malloc(len + 5);
+    if (tmp == NULL) {
+        destroyProm(promo);
+        return -1;
+    }
+    memcpy(tmp, snapshot_file, len);
+    memcpy(tmp + len, ".tmp", 5);
+
+    // Nouveau snapshot d’abord : tant que le journal n’est pas remplacé, il est périmé et ignoré
+    int status = saveSnapshotWithGeneration(tmp, promo, generation + 1);
+    destroyProm(promo);
+    if (status == 0 && rename(tmp, snapshot_file) != 0) {
+        perror("Erreur lors du remplacement du snapshot");
+        status = -1;
+    }
+    if (status != 0)
+        remove(tmp);
+    free(tmp);
+
+    if (status == 0)
+        status = resetJournal(journal_file, generation + 1);
+    return status;
+}
@@ -0,0 +1,187 @@
+/**
+ * @file journal.h
+ * @brief Journal en ajout seul des modifications d’une promotion, rejoué sur le dernier snapshot.
+ *
+ * Au lieu de réécrire toute la sauvegarde à chaque changement, les modifications
+ * (nouvelle note, nouvel étudiant, coefficient d’une matière) sont ajoutées à la
+ * fin d’un fichier journal sous forme de petites entrées binaires. La restauration
+ * relit le dernier snapshot puis rejoue le journal ; le compactage intègre le journal
+ * dans un nouveau snapshot et le vide.
+ *
+ * Format : un en-tête de 24 octets (`JOURNAL_MAGIC`, version, réservé, génération),
+ * puis des entrées composées d’un en-tête `JournalEntryHeader` et d’une charge utile
+ * en little-endian, protégée par un CRC32C. Une entrée incomplète ou altérée en fin
+ * de fichier (écriture interrompue) est ignorée au rejeu, et supprimée à la
+ * réouverture du journal pour que les nouvelles entrées suivent la dernière entrée valide.
+ * Une entrée altérée au milieu du journal n’est jamais supprimée : la réouverture échoue.
+ *
+ * Le snapshot et le journal portent un numéro de génération : un journal n’est rejoué
+ * que sur un snapshot de même génération. Le compactage écrit un snapshot de la
+ * génération suivante avant de remplacer le journal ; si l’opération est interrompue
+ * entre les deux, l’ancien journal, déjà intégré, est reconnu périmé et n’est pas
+ * rejoué une seconde fois.
+ *
+ * @see snapshot.h
+ */
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "./struct.h"
+
+/** @brief Nombre magique au début de chaque journal. */
+#define JOURNAL_MAGIC "PROMJRNL"
+
+/** @brief Version du format du journal (la version 1 n’avait pas de somme de contrôle). */
+#define JOURNAL_VERSION 2
+
+/** @brief Taille de l’en-tête du fichier journal en octets. */
+#define JOURNAL_HEADER_SIZE 24
+
+/** @brief Entrée « note » : numéro d’étudiant, note, nom de la matière. */
+#define JOURNAL_ENTRY_GRADE 1
+/** @brief Entrée « étudiant » : numéro, âge, prénom et nom. */
+#define JOURNAL_ENTRY_STUDENT 2
+/** @brief Entrée « coefficient » : coefficient et nom de la matière (créée si elle n’existe pas). */
+#define JOURNAL_ENTRY_COEFF 3
+
+/**
+ * @struct JournalEntryHeader
+ * @brief En-tête d’une entrée du journal (12 octets).
+ */
+typedef struct JournalEntryHeader {
+    uint32_t length;          /**< Taille de la charge utile en octets. */
+    uint16_t type;            /**< Type `JOURNAL_ENTRY_*`. */
+    uint16_t reserved;        /**< Réservé, à 0. */
+    uint32_t crc;             /**< CRC32C de la charge utile. */
+} JournalEntryHeader;
+
+/**
+ * @struct Journal
+ * @brief Journal ouvert en ajout.
+ */
+typedef struct Journal {
+    FILE* file;               /**< Fichier ouvert en ajout. */
+    int num_entries;          /**< Nombre d’entrées ajoutées depuis l’ouverture. */
+} Journal;
+
+/**
+ * @brief Ouvre en ajout le journal associé à un snapshot.
+ *
+ * Le journal est créé s’il n’existe pas, et recréé vide s’il est d’une génération
+ * antérieure au snapshot (son contenu y a déjà été intégré). Sinon, ses entrées sont
+ * vérifiées comme au rejeu : une dernière entrée laissée incomplète ou altérée par une
+ * écriture interrompue est coupée, pour ne pas masquer les entrées ajoutées ensuite.
+ * Une entrée altérée suivie d’autres entrées fait échouer l’ouverture, sans modifier
+ * le fichier.
+ *
+ * @param snapshot_file Nom du snapshot (voir `saveSnapshot()`).
+ * @param journal_file  Nom du fichier journal.
+ * @return Le journal ouvert, ou NULL si un des fichiers est invalide, si le journal
+ *         est corrompu ou s’il est plus récent que le snapshot.
+ *
+ * @note Le journal doit être fermé avec `closeJournal()`.
+ */
+Journal* openJournal(const char* snapshot_file, const char* journal_file);
+
+/**
+ * @brief Force l’écriture sur disque des entrées déjà ajoutées (`fsync`).
+ *
+ * @param j Journal ouvert.
+ * @return 0 si succès, -1 sinon.
+ */
+int syncJournal(Journal* j);
+
+/**
+ * @brief Ferme un journal.
+ *
+ * @param j Journal à fermer (NULL accepté).
+ */
+void closeJournal(Journal* j);
+
+/**
+ * @brief Ajoute une note à la promotion et l’enregistre dans le journal.
+ *
+ * La note est vérifiée (étudiant et matière connus, note valide), écrite dans le journal
+ * puis seulement appliquée : une modification visible en mémoire est toujours journalisée.
+ * Une note refusée n’écrit rien.
+ *
+ * @param j           Journal ouvert.
+ * @param promo       Promotion en mémoire.
+ * @param student_id  Numéro de l’étudiant.
+ * @param course_name Nom de la matière.
+ * @param grade       Note.
+ * @return 0 si succès, -1 sinon.
+ */
+int journalAddGrade(Journal* j, Prom* promo, int student_id, const char* course_name, float grade);
+
+/**
+ * @brief Ajoute un étudiant à la promotion et l’enregistre dans le journal.
+ *
+ * Comme pour `journalAddGrade()`, l’entrée est écrite avant l’ajout ; un numéro
+ * déjà utilisé est refusé sans rien écrire.
+ *
+ * @param j          Journal ouvert.
+ * @param promo      Promotion en mémoire.
+ * @param student_id Numéro de l’étudiant.
+ * @param first_name Prénom.
+ * @param last_name  Nom.
+ * @param age        Âge.
+ * @return 0 si succès, -1 sinon.
+ */
+int journalAddStudent(Journal* j, Prom* promo, int student_id, const char* first_name, const char* last_name, int age);
+
+/**
+ * @brief Fixe le coefficient d’une matière (en la créant si besoin) et l’enregistre dans le journal.
+ *
+ * L’entrée est écrite avant la modification ; un nom vide est refusé.
+ *
+ * @param j           Journal ouvert.
+ * @param promo       Promotion en mémoire.
+ * @param course_name Nom de la matière.
+ * @param coeff       Nouveau coefficient.
+ * @return 0 si succès, -1 sinon.
+ */
+int journalSetCoeff(Journal* j, Prom* promo, const char* course_name, float coeff);
+
+/**
+ * @brief Rejoue un journal sur une promotion.
+ *
+ * Les entrées invalides sont signalées et ignorées ; une entrée incomplète ou altérée
+ * en fin de fichier arrête le rejeu sans erreur. Une entrée altérée au milieu du
+ * journal arrête le rejeu avec un avertissement : les entrées suivantes sont ignorées.
+ * Un journal absent, ou d’une autre génération que `generation`, n’applique aucune entrée.
+ *
+ * @param filename   Nom du fichier journal.
+ * @param generation Génération du snapshot dont provient `promo`.
+ * @param promo      Promotion sur laquelle appliquer les entrées.
+ * @return Le nombre d’entrées appliquées, ou -1 si le fichier n’est pas un journal valide.
+ */
+int replayJournal(const char* filename, uint64_t generation, Prom* promo);
+
+/**
+ * @brief Restaure une promotion à partir d’un snapshot et de son journal.
+ *
+ * @param snapshot_file Nom du snapshot (voir `saveSnapshot()`).
+ * @param journal_file  Nom du journal.
+ * @param flags         Options de chargement (`LOAD_ARENA` est pris en compte).
+ * @return La promotion allouée dynamiquement, ou NULL en cas d’erreur.
+ */
+Prom* loadPromotionWithJournal(const char* snapshot_file, const char* journal_file, int flags);
+
+/**
+ * @brief Intègre le journal dans un nouveau snapshot puis vide le journal.
+ *
+ * Le nouveau snapshot est écrit dans un fichier temporaire puis renommé, de sorte
+ * qu’une interruption laisse toujours un snapshot et un journal cohérents. Aucun
+ * journal ne doit être ouvert en ajout sur `journal_file` pendant l’appel.
+ *
+ * @param snapshot_file Nom du snapshot.
+ * @param journal_file  Nom du journal.
+ * @return 0 si succès, -1 sinon.
+ */
+int compactJournal(const char* snapshot_file, const char* journal_file);
+
+#endif // JOURNAL_H
@@ -0,0 +1,384 @@
+/**
+ * @file leaderboard.c
+ * @brief Listes à enjambements des classements général et par matière d’une promotion.
+ *
+ * @see leaderboard.h
+ */
+
+#include <stdlib.h>
+#include "./leaderboard.h"
+#include "./struct_functions.h"
+
+/**
+ * @struct RankKey
+ * @brief Clé de classement : moyenne décroissante, puis position, puis adresse (identifiants dupliqués).
+ */
+typedef struct RankKey {
+    float average;
+    int position;
+    const Student* student;
+    int enrollment;
+} RankKey;
+
+/**
+ * @brief Clé d’un nœud.
+ */
+static RankKey nodeKey(const LeaderboardNode* node) {
+    return (RankKey){ node->average, node->position, node->student, node->enrollment };
+}
+
+/**
+ * @brief Indique si la clé `a` est classée avant `b` (même ordre que la sélection par tas).
+ */
+static int keyBefore(const RankKey* a, const RankKey* b) {
+    if (a->average != b->average)
+        return a->average > b->average;
+    if (a->position != b->position)
+        return a->position < b->position;
+    if (a->student != b->student)
+        return (uintptr_t)a->student < (uintptr_t)b->student;
+    return a->enrollment < b->enrollment;
+}
+
+/**
+ * @brief Indique si deux clés désignent le même nœud.
+ */
+static int keyEquals(const RankKey* a, const RankKey* b) {
+    return a->average == b->average && a->position == b->position &&
+           a->student == b->student && a->enrollment == b->enrollment;
+}
+
+/**
+ * @brief Initialise un classement vide.
+ */
+static int initLeaderboard(Leaderboard* lb) {
+    lb->head = calloc(1, sizeof(LeaderboardNode) + sizeof(LeaderboardNode*) * LEADERBOARD_MAX_LEVEL);
+    if (lb->head == NULL)
+        return -1;
+    lb->head->level = LEADERBOARD_MAX_LEVEL;
+    lb->level = 1;
+    lb->size = 0;
+    lb->seed = 0x9E3779B9u;
+    return 0;
+}
+
+/**
+ * @brief Libère tous les nœuds d’un classement.
+ */
+static void freeLeaderboard(Leaderboard* lb) {
+    LeaderboardNode* node = lb->head;
+    while (node != NULL) {
+        LeaderboardNode* next = node->next[0];
+        free(node);
+        node = next;
+    }
+    lb->head = NULL;
+}
+
+/**
+ * @brief Tire le nombre de niveaux d’un nouveau nœud (loi géométrique de raison 1/4).
+ */
+static int randomLevel(Leaderboard* lb) {
+    // xorshift32 : 2 bits par niveau, 32 bits suffisent pour LEADERBOARD_MAX_LEVEL
+    uint32_t x = lb->seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    lb->seed = x;
+
+    int level = 1;
+    while (level < LEADERBOARD_MAX_LEVEL && (x & 3) == 0) {
+        level++;
+        x >>= 2;
+    }
+    return level;
+}
+
+/**
+ * @brief Remplit `update` avec le dernier nœud classé avant `key` à chaque niveau.
+ */
+static void findPredecessors(const Leaderboard* lb, const RankKey* key, LeaderboardNode** update) {
+    LeaderboardNode* node = lb->head;
+    for (int i = lb->level - 1; i >= 0; i--) {
+        while (node->next[i] != NULL) {
+            RankKey next = nodeKey(node->next[i]);
+            if (!keyBefore(&next, key))
+                break;
+            node = node->next[i];
+        }
+        update[i] = node;
+    }
+}
+
+/**
+ * @brief Insère un nœud déjà rempli à sa place.
+ */
+static void linkNode(Leaderboard* lb, LeaderboardNode* node) {
+    LeaderboardNode* update[LEADERBOARD_MAX_LEVEL];
+    RankKey key = nodeKey(node);
+
+    if (node->level > lb->level) {
+        for (int i = lb->level; i < node->level; i++)
+            lb->head->next[i] = NULL;
+        lb->level = node->level;
+    }
+    findPredecessors(lb, &key, update);
+
+    for (int i = 0; i < node->level; i++) {
+        node->next[i] = update[i]->next[i];
+        update[i]->next[i] = node;
+    }
+    lb->size++;
+}
+
+/**
+ * @brief Retire le nœud de clé `key` sans le libérer.
+ *
+ * @return Le nœud retiré, ou NULL s’il n’est pas dans le classement.
+ */
+static LeaderboardNode* unlinkNode(Leaderboard* lb, const RankKey* key) {
+    LeaderboardNode* update[LEADERBOARD_MAX_LEVEL];
+    findPredecessors(lb, key, update);
+
+    LeaderboardNode* node = update[0]->next[0];
+    if (node == NULL)
+        return NULL;
+    RankKey found = nodeKey(node);
+    if (!keyEquals(&found, key))
+        return NULL;
+
+    for (int i = 0; i < node->level; i++)
+        update[i]->next[i] = node->next[i];
+    while (lb->level > 1 && lb->head->next[lb->level - 1] == NULL)
+        lb->level--;
+    lb->size--;
+    return node;
+}
+
+/**
+ * @brief Alloue et classe un nouveau nœud.
+ *
+ * @return 0 si succès, -1 en cas d’erreur d’allocation.
+ */
+static int insertNode(Leaderboard* lb, const RankKey* key) {
+    int level = randomLevel(lb);
+    LeaderboardNode* node = malloc(sizeof(LeaderboardNode) + sizeof(LeaderboardNode*) * level);
+    if (node == NULL)
+        return -1;
+
+    node->average = key->average;
+    node->position = key->position;
+    node->student = (Student*)key->student;
+    node->enrollment = key->enrollment;
+    node->level = level;
+    linkNode(lb, node);
+    return 0;
+}
+
+/**
+ * @brief Déplace le nœud de clé `old_key` à la place de sa nouvelle moyenne, sans allocation.
+ *
+ * @return 0 si succès, -1 si le nœud n’est pas dans le classement.
+ */
+static int moveNode(Leaderboard* lb, const RankKey* old_key, float average) {
+    LeaderboardNode* node = unlinkNode(lb, old_key);
+    if (node == NULL)
+        return -1;
+    node->average = average;
+    linkNode(lb, node);
+    return 0;
+}
+
+/**
+ * @brief Clé d’un étudiant dans le classement général.
+ */
+static RankKey generalKey(const Prom* p, const Student* s, float average) {
+    return (RankKey){ average, findStudentPosition(p, s->student_id), s, -1 };
+}
+
+/**
+ * @brief Clé d’une inscription dans le classement de sa matière.
+ */
+static RankKey courseKey(const Prom* p, const Student* s, int enrollment, float average) {
+    return (RankKey){ average, findStudentPosition(p, s->student_id), s, enrollment };
+}
+
+/**
+ * @brief Ajoute des classements vides jusqu’à en avoir un par matière du catalogue.
+ */
+static int growCourseBoards(Leaderboards* boards, int num_courses) {
+    if (num_courses > boards->courses_capacity) {
+        int new_capacity = boards->courses_capacity > 0 ? boards->courses_capacity : 16;
+        while (new_capacity < num_courses)
+            new_capacity *= 2;
+        Leaderboard* tmp = realloc(boards->courses, sizeof(Leaderboard) * new_capacity);
+        if (tmp == NULL)
+            return -1;
+        boards->courses = tmp;
+        boards->courses_capacity = new_capacity;
+    }
+
+    while (boards->num_courses < num_courses) {
+        if (initLeaderboard(&boards->courses[boards->num_courses]) == -1)
+            return -1;
+        boards->num_courses++;
+    }
+    return 0;
+}
+
+/**
+ * @brief Classe tous les étudiants et toutes les inscriptions dans des classements vides.
+ *
+ * @return 0 si succès, -1 en cas d’erreur d’allocation.
+ */
+static int fillLeaderboards(const Prom* p, Leaderboards* boards) {
+    if (initLeaderboard(&boards->general) == -1 || growCourseBoards(boards, p->num_courses) == -1)
+        return -1;
+
+    for (int i = 0; i < p->num_students; i++) {
+        Student* s = p->students[i];
+        RankKey key = generalKey(p, s, s->general_average);
+        if (insertNode(&boards->general, &key) == -1)
+            return -1;
+    }
+
+    for (int c = 0; c < p->num_courses; c++) {
+        const CourseRoster* roster = &p->rosters[c];
+        for (int i = 0; i < roster->size; i++) {
+            const RosterEntry* entry = &roster->entries[i];
+            RankKey key = courseKey(p, entry->student, entry->enrollment,
+                                    entry->student->courses[entry->enrollment].average);
+            if (insertNode(&boards->courses[c], &key) == -1)
+                return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Construit les classements d’une promotion à partir de son état actuel.
+ */
+int enableLeaderboards(Prom* p) {
+    if (p == NULL)
+        return -1;
+    if (p->leaderboards != NULL)
+        return 0;
+
+    p->leaderboards = calloc(1, sizeof(Leaderboards));
+    if (p->leaderboards == NULL)
+        return -1;
+
+    if (fillLeaderboards(p, p->leaderboards) == -1) {
+        disableLeaderboards(p);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Supprime les classements d’une promotion.
+ */
+void disableLeaderboards(Prom* p) {
+    if (p == NULL || p->leaderboards == NULL)
+        return;
+
+    Leaderboards* boards = p->leaderboards;
+    freeLeaderboard(&boards->general);
+    for (int c = 0; c < boards->num_courses; c++)
+        freeLeaderboard(&boards->courses[c]);
+    free(boards->courses);
+    free(boards);
+    p->leaderboards = NULL;
+}
+
+/**
+ * @brief Classe un étudiant qui vient d’être ajouté à la promotion.
+ */
+void leaderboardsAddStudent(Prom* p, Student* s) {
+    if (p == NULL || p->leaderboards == NULL)
+        return;
+
+    RankKey key = generalKey(p, s, s->general_average);
+    if (insertNode(&p->leaderboards->general, &key) == -1)
+        disableLeaderboards(p);
+}
+
+/**
+ * @brief Ajoute le classement d’une matière qui vient d’être ajoutée au catalogue.
+ */
+void leaderboardsAddCourse(Prom* p) {
+    if (p == NULL || p->leaderboards == NULL)
+        return;
+
+    if (growCourseBoards(p->leaderboards, p->num_courses) == -1)
+        disableLeaderboards(p);
+}
+
+/**
+ * @brief Classe une inscription qui vient d’être ajoutée à la liste des inscrits.
+ */
+void leaderboardsAddEnrollment(Prom* p, Student* s, int enrollment) {
+    if (p == NULL || p->leaderboards == NULL)
+        return;
+
+    const Enrollment* e = &s->courses[enrollment];
+    RankKey key = courseKey(p, s, enrollment, e->average);
+    if (insertNode(&p->leaderboards->courses[e->course_index], &key) == -1)
+        disableLeaderboards(p);
+}
+
+/**
+ * @brief Replace un étudiant dans le classement général après un changement de moyenne.
+ */
+void leaderboardsUpdateGeneral(Prom* p, Student* s, float old_average) {
+    if (p == NULL || p->leaderboards == NULL || s->general_average == old_average)
+        return;
+
+    // Nœud introuvable : la moyenne a été modifiée sans passer par l’API
+    RankKey key = generalKey(p, s, old_average);
+    if (moveNode(&p->leaderboards->general, &key, s->general_average) == -1)
+        disableLeaderboards(p);
+}
+
+/**
+ * @brief Replace une inscription dans le classement de sa matière après un changement de moyenne.
+ */
+void leaderboardsUpdateCourse(Prom* p, Student* s, int enrollment, float old_average) {
+    if (p == NULL || p->leaderboards == NULL || s->courses[enrollment].average == old_average)
+        return;
+
+    const Enrollment* e = &s->courses[enrollment];
+
+    RankKey key = courseKey(p, s, enrollment, old_average);
+    if (moveNode(&p->leaderboards->courses[e->course_index], &key, e->average) == -1)
+        disableLeaderboards(p);
+}
+
+/**
+ * @brief Lit les `k` premiers du classement général.
+ */
+int leaderboardTopStudents(const Prom* p, int k, Student** out) {
+    if (p == NULL || p->leaderboards == NULL)
+        return -1;
+
+    int count = 0;
+    for (const LeaderboardNode* node = p->leaderboards->general.head->next[0];
+         node != NULL && count < k; node = node->next[0])
+        out[count++] = node->student;
+    return count;
+}
+
+/**
+ * @brief Lit les `k` premiers du classement d’une matière.
+ */
+int leaderboardTopCourse(const Prom* p, int course_index, int k, RosterEntry* out) {
+    if (p == NULL || p->leaderboards == NULL || course_index < 0 ||
+        course_index >= p->leaderboards->num_courses)
+        return -1;
+
+    int count = 0;
+    for (const LeaderboardNode* node = p->leaderboards->courses[course_index].head->next[0];
+         node != NULL && count < k; node = node->next[0])
+        out[count++] = (RosterEntry){ node->student, node->enrollment };
+    return count;
+}
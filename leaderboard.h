@@ -0,0 +1,147 @@
+/**
+ * @file leaderboard.h
+ * @brief Classements d’une promotion maintenus au fil des ajouts (listes à enjambements).
+ *
+ * Une promotion peut tenir, en option, un classement par moyenne générale et un
+ * classement par matière. Chacun est une liste à enjambements (« skip list ») triée
+ * par moyenne décroissante, puis par position dans la promotion : les `k` premiers
+ * se lisent en O(k), sans tri ni parcours de la promotion.
+ *
+ * Les classements sont construits par `enableLeaderboards()`, en général après le
+ * chargement. Les fonctions de modification de `struct_functions.h` les tiennent
+ * ensuite à jour : un ajout de note ne déplace que deux nœuds (la matière et la
+ * moyenne générale), en O(log n). `getTopKStudents()` et `getTopKStudentsCourse()`
+ * s’en servent lorsqu’ils existent.
+ *
+ * Si une allocation échoue pendant une mise à jour, les classements sont supprimés
+ * et les requêtes reviennent à la sélection par tas : le résultat reste le même.
+ *
+ * @see file_sorting.h
+ */
+
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include <stdint.h>
+#include "./struct.h"
+
+/** @brief Nombre maximal de niveaux d’une liste (une chance sur 4 de monter d’un niveau). */
+#define LEADERBOARD_MAX_LEVEL 16
+
+/**
+ * @struct LeaderboardNode
+ * @brief Nœud d’un classement : un étudiant, ou une inscription pour une matière.
+ */
+typedef struct LeaderboardNode {
+    float average;          /**< Moyenne utilisée pour le classement (copie de celle de l’étudiant). */
+    int position;           /**< Position de l’étudiant dans la promotion, pour départager les égalités. */
+    Student* student;       /**< Étudiant classé. */
+    int enrollment;         /**< Position de l’inscription dans `student->courses`, -1 pour la moyenne générale. */
+    int level;              /**< Nombre de niveaux du nœud. */
+    struct LeaderboardNode* next[]; /**< Successeur à chaque niveau. */
+} LeaderboardNode;
+
+/**
+ * @struct Leaderboard
+ * @brief Liste à enjambements triée par moyenne décroissante.
+ */
+typedef struct Leaderboard {
+    LeaderboardNode* head;  /**< Nœud sentinelle à `LEADERBOARD_MAX_LEVEL` niveaux. */
+    int level;              /**< Nombre de niveaux utilisés. */
+    int size;               /**< Nombre de nœuds classés. */
+    uint32_t seed;          /**< État du générateur pseudo-aléatoire des niveaux. */
+} Leaderboard;
+
+/**
+ * @struct Leaderboards
+ * @brief Classement général et classements par matière d’une promotion.
+ */
+typedef struct Leaderboards {
+    Leaderboard general;    /**< Classement par moyenne générale. */
+    Leaderboard* courses;   /**< Classement de chaque matière, parallèle à `Prom.courses`. */
+    int num_courses;        /**< Nombre de classements de matières. */
+    int courses_capacity;   /**< Nombre de classements de matières alloués. */
+} Leaderboards;
+
+/**
+ * @brief Construit les classements d’une promotion à partir de son état actuel.
+ *
+ * Coût O(n log n) ; sans effet si les classements existent déjà.
+ *
+ * @param p Pointeur vers la promotion.
+ * @return 0 si succès, -1 en cas d’erreur d’allocation ou d’argument invalide.
+ */
+int enableLeaderboards(Prom* p);
+
+/**
+ * @brief Supprime les classements d’une promotion.
+ *
+ * @param p Pointeur vers la promotion (peut être NULL).
+ */
+void disableLeaderboards(Prom* p);
+
+/**
+ * @brief Classe un étudiant qui vient d’être ajouté à la promotion.
+ *
+ * @param p Pointeur vers la promotion.
+ * @param s Étudiant ajouté.
+ */
+void leaderboardsAddStudent(Prom* p, Student* s);
+
+/**
+ * @brief Ajoute le classement d’une matière qui vient d’être ajoutée au catalogue.
+ *
+ * @param p Pointeur vers la promotion.
+ */
+void leaderboardsAddCourse(Prom* p);
+
+/**
+ * @brief Classe une inscription qui vient d’être ajoutée à la liste des inscrits.
+ *
+ * @param p          Pointeur vers la promotion.
+ * @param s          Étudiant inscrit.
+ * @param enrollment Position de l’inscription dans `s->courses`.
+ */
+void leaderboardsAddEnrollment(Prom* p, Student* s, int enrollment);
+
+/**
+ * @brief Replace un étudiant dans le classement général après un changement de moyenne.
+ *
+ * @param p           Pointeur vers la promotion.
+ * @param s           Étudiant, dont `general_average` est déjà à jour.
+ * @param old_average Moyenne générale sous laquelle il était classé.
+ */
+void leaderboardsUpdateGeneral(Prom* p, Student* s, float old_average);
+
+/**
+ * @brief Replace une inscription dans le classement de sa matière après un changement de moyenne.
+ *
+ * @param p           Pointeur vers la promotion.
+ * @param s           Étudiant inscrit.
+ * @param enrollment  Position de l’inscription dans `s->courses`, dont la moyenne est déjà à jour.
+ * @param old_average Moyenne sous laquelle elle était classée.
+ */
+void leaderboardsUpdateCourse(Prom* p, Student* s, int enrollment, float old_average);
+
+/**
+ * @brief Lit les `k` premiers du classement général.
+ *
+ * @param p   Pointeur vers la promotion.
+ * @param k   Nombre d’étudiants demandés.
+ * @param out Tableau d’au moins `k` pointeurs.
+ * @return Le nombre d’étudiants écrits (≤ k), ou -1 si la promotion n’a pas de classements.
+ */
+int leaderboardTopStudents(const Prom* p, int k, Student** out);
+
+/**
+ * @brief Lit les `k` premiers du classement d’une matière.
+ *
+ * @param p            Pointeur vers la promotion.
+ * @param course_index Indice de la matière dans `Prom.courses`.
+ * @param k            Nombre d’inscrits demandés.
+ * @param out          Tableau d’au moins `k` entrées.
+ * @return Le nombre d’inscrits écrits (≤ k), ou -1 si la promotion n’a pas de classements.
+ */
+int leaderboardTopCourse(const Prom* p, int course_index, int k, RosterEntry* out);
+
+#endif // LEADERBOARD_H
@@ -12,6 +12,18 @@
  * - **struct.h / struct_functions.c** : définition et gestion des structures principales (`Student`, `Course`, `Prom`, etc.)
  * - **file_gestion.c** : lecture et écriture des fichiers (texte et binaire)
  * - **file_sorting.c** : fonctions de tri et de classement des étudiants
+ * - **arena.c** : allocateur par régions utilisé par les promotions en mode arène
+ * - **tokenizer.c** : découpage sans copie des lignes du fichier texte et conversion des champs
+ * - **prom_columns.c** : représentation en colonnes d’une promotion (tableaux denses, notes au format CSR)
+ * - **snapshot.c** : snapshot binaire (sections à plat, projection mémoire et lecture en place)
+ * - **journal.c** : journal en ajout seul des modifications, rejoué sur le snapshot et compacté
+ * - **crc32c.c** : somme de contrôle CRC32C (SSE4.2 ou slice-by-8) des snapshots et du journal
+ * - **leaderboard.c** : classements général et par matière (listes à enjambements) tenus à jour à chaque note
+ * - **ranking.c** : classement complet par tri par base des moyennes (rang, centile, tranches de rangs)
+ * - **grade_kernels.c** : noyaux vectoriels (AVX2, SSE2 ou scalaire, choisis à l’exécution) des sommes de notes et des moyennes
+ * - **course_stats.c** : statistiques de chaque matière (moyenne, écart type, quartiles, histogramme), calculées en parallèle
+ * - **campus.c** : chargement parallèle de plusieurs promotions et classements fusionnés à l’échelle du campus
+ * - **report.c** : export d’une promotion en texte, CSV ou JSON Lines, par un tampon unique et de gros `write`
  * - **main.c** : fonction principale, lancement du programme
  *
  * \section usage_sec Compilation et exécution
@@ -24,6 +36,10 @@
  * ```
  * ./exec data.txt
  * ```
+ * ou, pour plusieurs promotions chargées en parallèle :
+ * ```
+ * ./exec promo1.txt promo2.txt ...
+ * ```
  *
  * \section doxy_sec Documentation
  *
@@ -39,10 +55,53 @@
 #include "./struct_functions.h"
 #include "./file_gestion.h"
 #include "./file_sorting.h"
+#include "./campus.h"
+
+
+/**
+ * @brief Charge plusieurs promotions en parallèle et affiche les classements du campus.
+ *
+ * @param num_files Nombre de fichiers.
+ * @param filenames Chemins des fichiers texte.
+ * @return EXIT_SUCCESS, ou EXIT_FAILURE en cas d’erreur.
+ */
+static int runCampus(int num_files, char** filenames) {
+    Campus* c = loadCampus(filenames, num_files, LOAD_PRESIZE | LOAD_ARENA, 0);
+    if (c == NULL) {
+        fprintf(stderr, "Erreur critique de chargement.\n");
+        return EXIT_FAILURE;
+    }
+
+    CampusEntry top[10];
+    int count = 0;
+    if (getCampusTopKStudents(c, 10, top, &count) == -1) {
+        fprintf(stderr, "Erreur Allocation Mémoire\n");
+        destroyCampus(c);
+        return EXIT_FAILURE;
+    }
+
+    printf("--- Top %d students (%d promotions) ---\n", count, c->num_promos);
+    for (int i = 0; i < count; i++)
+        printf("%s (%s): %.2f\n", top[i].student->first_name, filenames[top[i].promo_index],
+               top[i].student->general_average);
+
+    char* course = "Geographie";
+    if (getCampusTopKStudentsCourse(c, course, 3, top, &count) == 0) {
+        printf("\n--- Top %d Students in %s ---\n", count, course);
+        for (int i = 0; i < count; i++)
+            printf("%s (%s): %.2f\n", top[i].student->first_name, filenames[top[i].promo_index],
+                   top[i].student->courses[top[i].enrollment].average);
+    }
+
+    destroyCampus(c);
+    return EXIT_SUCCESS;
+}
 
 
 int main(int argc, char* argv[]) {
     checkArguments(argc);
+    if (argc > 2)
+        return runCampus(argc - 1, argv + 1);
 
     Prom* p = loadPromotionFromFile(argv[1]);
     if (p == NULL) {
@@ -82,7 +141,7 @@ int main(int argc, char* argv[]) {
     }
 
     char* course = "Geographie";
-    Student** top_three = getTopThreeStudentsCourse(p_loaded, course, &count);
+    RosterEntry* top_three = getTopThreeStudentsCourse(p_loaded, course, &count);
     if (top_three == NULL) {
         fprintf(stderr, "Erreur Allocation Mémoire\n");
         free(top_ten);
@@ -91,7 +150,8 @@ int main(int argc, char* argv[]) {
 
     printf("\n--- Top %d Students in %s ---\n", count, course);
     for (int i = 0; i < count; i++) {
-        printf("%s: %.2f\n", top_three[i]->first_name, top_three[i]->courses[0]->average);
+        const Student* s = top_three[i].student;
+        printf("%s: %.2f\n", s->first_name, s->courses[top_three[i].enrollment].average);
     }
 
     // Libération finale
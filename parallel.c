@@ -0,0 +1,49 @@
+/**
+ * @file parallel.c
+ * @brief Choix du nombre de threads et exécution d’une fonction sur des morceaux de travail.
+ *
+ * @see parallel.h
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <pthread.h>
+#include <unistd.h>
+#include "./parallel.h"
+
+/**
+ * @brief Choisit le nombre de threads d’un calcul parallèle.
+ */
+int parallelThreadCount(int num_threads, size_t auto_limit, size_t limit) {
+    if (num_threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = (cpus > 0) ? (int)cpus : 1;
+        if ((size_t)num_threads > auto_limit)
+            num_threads = auto_limit > 0 ? (int)auto_limit : 1;
+    }
+    if (num_threads > PARALLEL_MAX_THREADS)
+        num_threads = PARALLEL_MAX_THREADS;
+    if ((size_t)num_threads > limit)
+        num_threads = limit > 0 ? (int)limit : 1;
+    return num_threads;
+}
+
+/**
+ * @brief Exécute une fonction sur chaque morceau, un thread par morceau.
+ */
+void runParallel(void* chunks, size_t chunk_size, int nb_chunks, void* (*work)(void*)) {
+    pthread_t threads[PARALLEL_MAX_THREADS];
+    int started[PARALLEL_MAX_THREADS];
+    char* base = chunks;
+
+    for (int k = 0; k < nb_chunks - 1; k++)
+        started[k] = pthread_create(&threads[k], NULL, work, base + k * chunk_size) == 0;
+    work(base + (size_t)(nb_chunks - 1) * chunk_size);
+
+    for (int k = 0; k < nb_chunks - 1; k++) {
+        if (started[k])
+            pthread_join(threads[k], NULL);
+        else
+            work(base + k * chunk_size);
+    }
+}
@@ -0,0 +1,43 @@
+/**
+ * @file parallel.h
+ * @brief Exécution d’une même fonction sur plusieurs morceaux de travail, un thread par morceau.
+ *
+ * Utilisé par le chargement parallèle de la section NOTES (file_gestion.c), les
+ * statistiques par matière (course_stats.c) et le chargement d’un campus (campus.c).
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <stddef.h>
+
+/** @brief Nombre maximal de threads d’un calcul parallèle. */
+#define PARALLEL_MAX_THREADS 64
+
+/**
+ * @brief Choisit le nombre de threads d’un calcul parallèle.
+ *
+ * @param num_threads Nombre demandé ; 0 ou moins : un par processeur, au plus `auto_limit`.
+ * @param auto_limit  Nombre de morceaux qui valent un thread en mode automatique
+ *                    (par exemple la taille du travail divisée par une taille minimale).
+ * @param limit       Nombre de morceaux possibles, dans tous les cas.
+ * @return Un nombre entre 1 et `PARALLEL_MAX_THREADS`.
+ */
+int parallelThreadCount(int num_threads, size_t auto_limit, size_t limit);
+
+/**
+ * @brief Exécute une fonction sur chaque morceau, un thread par morceau.
+ *
+ * Le morceau `k` reçoit `(char*)chunks + k * chunk_size` ; avec `chunk_size` nul, tous
+ * reçoivent `chunks` (une file de travail partagée, par exemple). Le dernier morceau
+ * est traité par le thread appelant ; si un thread ne peut pas être créé, son morceau
+ * est lui aussi traité par l’appelant. La fonction retourne quand tous sont traités.
+ *
+ * @param chunks     Morceaux de travail.
+ * @param chunk_size Taille d’un morceau, en octets.
+ * @param nb_chunks  Nombre de morceaux, entre 1 et `PARALLEL_MAX_THREADS`.
+ * @param work       Fonction appliquée à chaque morceau.
+ */
+void runParallel(void* chunks, size_t chunk_size, int nb_chunks, void* (*work)(void*));
+
+#endif // PARALLEL_H
@@ -0,0 +1,242 @@
+/**
+ * @file prom_columns.c
+ * @brief Construction et parcours de la représentation en colonnes d’une promotion.
+ *
+ * @see prom_columns.h
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "./prom_columns.h"
+#include "./struct_functions.h"
+#include "./file_gestion.h"
+#include "./grade_kernels.h"
+
+/**
+ * @brief Construit la représentation en colonnes d’une promotion chargée.
+ */
+PromColumns* createPromColumns(const Prom* p) {
+    if (p == NULL || p->aggregate_only)
+        return NULL;
+
+    PromColumns* cols = calloc(1, sizeof(PromColumns));
+    if (cols == NULL)
+        return NULL;
+
+    int nb_students = p->num_students;
+    int nb_courses = p->num_courses;
+    size_t nb_cells = (size_t)nb_students * nb_courses;
+    if (nb_cells >= INT_MAX) {   // cases indexées sur 32 bits par les noyaux
+        free(cols);
+        return NULL;
+    }
+    cols->num_students = nb_students;
+    cols->num_courses = nb_courses;
+
+    cols->student_ids = malloc(sizeof(int) * (nb_students > 0 ? nb_students : 1));
+    cols->ages = malloc(sizeof(int) * (nb_students > 0 ? nb_students : 1));
+    cols->general_averages = malloc(sizeof(float) * (nb_students > 0 ? nb_students : 1));
+    cols->course_coeffs = malloc(sizeof(float) * (nb_courses > 0 ? nb_courses : 1));
+    cols->course_averages = calloc(nb_cells > 0 ? nb_cells : 1, sizeof(float));
+    cols->grade_offsets = calloc(nb_cells + 1, sizeof(int));
+    if (cols->student_ids == NULL || cols->ages == NULL || cols->general_averages == NULL ||
+        cols->course_coeffs == NULL || cols->course_averages == NULL || cols->grade_offsets == NULL) {
+        destroyPromColumns(cols);
+        return NULL;
+    }
+
+    for (int c = 0; c < nb_courses; c++)
+        cols->course_coeffs[c] = p->courses[c].coeff;
+
+    // Première passe : attributs des étudiants et nombre de notes de chaque case
+    for (int i = 0; i < nb_students; i++) {
+        const Student* s = p->students[i];
+        cols->student_ids[i] = s->student_id;
+        cols->ages[i] = s->age;
+        cols->general_averages[i] = s->general_average;
+        int graded = 0;
+        for (int j = 0; j < s->num_courses; j++) {
+            const Enrollment* e = &s->courses[j];
+            size_t cell = (size_t)e->course_index * nb_students + i;
+            cols->grade_offsets[cell + 1] = e->grades.size;
+            if (e->grades.size > 0) {
+                cols->course_averages[cell] = e->average;
+                graded++;
+            }
+        }
+        if (graded > cols->max_enrollments)
+            cols->max_enrollments = graded;
+    }
+
+    // Décalages CSR : somme cumulée des nombres de notes
+    for (size_t cell = 0; cell < nb_cells; cell++)
+        cols->grade_offsets[cell + 1] += cols->grade_offsets[cell];
+    cols->num_grades = cols->grade_offsets[nb_cells];
+
+    size_t nb_ranks = (size_t)cols->max_enrollments * nb_students;
+    cols->grades = malloc(sizeof(uint8_t) * (cols->num_grades > 0 ? cols->num_grades : 1));
+    cols->enrollment_courses = malloc(sizeof(int) * (nb_ranks > 0 ? nb_ranks : 1));
+    if (cols->grades == NULL || cols->enrollment_courses == NULL) {
+        destroyPromColumns(cols);
+        return NULL;
+    }
+    memset(cols->enrollment_courses, -1, sizeof(int) * nb_ranks);
+
+    // Seconde passe : recopie des notes à leur place et cours notés dans l’ordre des inscriptions
+    for (int i = 0; i < nb_students; i++) {
+        const Student* s = p->students[i];
+        int rank = 0;
+        for (int j = 0; j < s->num_courses; j++) {
+            const Enrollment* e = &s->courses[j];
+            size_t cell = (size_t)e->course_index * nb_students + i;
+            if (e->grades.size == 0)
+                continue;
+            memcpy(&cols->grades[cols->grade_offsets[cell]], e->grades.grades_array,
+                   sizeof(uint8_t) * e->grades.size);
+            cols->enrollment_courses[(size_t)rank++ * nb_students + i] = e->course_index;
+        }
+    }
+
+    return cols;
+}
+
+/**
+ * @brief Charge directement un fichier texte sous forme de colonnes.
+ */
+PromColumns* loadPromColumnsFromFile(char* filename, int flags) {
+    Prom* p = loadPromotionFromFileEx(filename, flags | LOAD_ARENA);
+    if (p == NULL)
+        return NULL;
+
+    PromColumns* cols = createPromColumns(p);
+    destroyProm(p);
+    return cols;
+}
+
+/**
+ * @brief Libère toutes les colonnes.
+ */
+void destroyPromColumns(PromColumns* cols) {
+    if (cols == NULL)
+        return;
+
+    free(cols->student_ids);
+    free(cols->ages);
+    free(cols->general_averages);
+    free(cols->enrollment_courses);
+    free(cols->course_coeffs);
+    free(cols->course_averages);
+    free(cols->grade_offsets);
+    free(cols->grades);
+    free(cols);
+}
+
+/**
+ * @brief Retourne les `k` meilleures moyennes générales.
+ *
+ * Les `k` meilleurs sont gardés triés pendant un unique parcours de la colonne ;
+ * une moyenne n’est insérée que si elle dépasse strictement la dernière retenue.
+ */
+int getTopStudentsColumns(const PromColumns* cols, int k, int* rows) {
+    if (cols == NULL || rows == NULL || k <= 0)
+        return 0;
+
+    const float* averages = cols->general_averages;
+    int count = 0;
+    for (int i = 0; i < cols->num_students; i++) {
+        float avg = averages[i];
+        if (count == k && avg <= averages[rows[k - 1]])
+            continue;
+
+        int pos = (count < k) ? count++ : k - 1;
+        while (pos > 0 && averages[rows[pos - 1]] < avg) {
+            rows[pos] = rows[pos - 1];
+            pos--;
+        }
+        rows[pos] = i;
+    }
+    return count;
+}
+
+/**
+ * @brief Calcule la moyenne d’un cours sur les étudiants inscrits.
+ */
+float getCourseMeanColumns(const PromColumns* cols, int course_index, int* count) {
+    if (count != NULL)
+        *count = 0;
+    if (cols == NULL || course_index < 0 || course_index >= cols->num_courses)
+        return 0;
+
+    size_t first = (size_t)course_index * cols->num_students;
+    const float* averages = &cols->course_averages[first];
+    const int* offsets = &cols->grade_offsets[first];
+
+    double sum = 0.0;
+    int enrolled = 0;
+    for (int i = 0; i < cols->num_students; i++) {
+        if (offsets[i + 1] == offsets[i])
+            continue;
+        sum += averages[i];
+        enrolled++;
+    }
+
+    if (count != NULL)
+        *count = enrolled;
+    return enrolled > 0 ? (float)(sum / enrolled) : 0;
+}
+
+/**
+ * @brief Recalcule les moyennes générales à partir de la matrice des moyennes, rang d’inscription par rang.
+ */
+static int computeGeneralAverages(PromColumns* cols) {
+    size_t n = (size_t)cols->num_students;
+    float* totals = calloc(n > 0 ? n : 1, sizeof(float));
+    float* coeff_totals = calloc(n > 0 ? n : 1, sizeof(float));
+    if (totals == NULL || coeff_totals == NULL) {
+        free(totals);
+        free(coeff_totals);
+        return -1;
+    }
+
+    // Chaque étudiant cumule ses cours dans l’ordre de ses inscriptions, comme
+    // `updateGeneralAverage()` : un appel par rang, tous les étudiants à la fois
+    for (int r = 0; r < cols->max_enrollments; r++)
+        addWeightedRank(totals, coeff_totals, cols->course_averages, cols->course_coeffs,
+                        &cols->enrollment_courses[(size_t)r * n], n);
+    weightedAverages(cols->general_averages, totals, coeff_totals, n);
+
+    free(totals);
+    free(coeff_totals);
+    return 0;
+}
+
+/**
+ * @brief Recalcule toutes les moyennes de cours et toutes les moyennes générales à partir des notes.
+ */
+int refreshColumnsAverages(PromColumns* cols) {
+    if (cols == NULL)
+        return -1;
+
+    size_t nb_cells = (size_t)cols->num_students * cols->num_courses;
+    int* sums = malloc(sizeof(int) * (nb_cells > 0 ? nb_cells : 1));
+    if (sums == NULL)
+        return -1;
+
+    sumGradeSegments(cols->grades, cols->grade_offsets, sums, nb_cells);
+    averagesFromSums(sums, cols->grade_offsets, cols->course_averages, nb_cells);
+    free(sums);
+
+    return computeGeneralAverages(cols);
+}
+
+/**
+ * @brief Modifie le coefficient d’un cours et recalcule les moyennes générales.
+ */
+int setCourseCoeffColumns(PromColumns* cols, int course_index, float coeff) {
+    if (cols == NULL || course_index < 0 || course_index >= cols->num_courses)
+        return -1;
+
+    cols->course_coeffs[course_index] = coeff;
+    return computeGeneralAverages(cols);
+}
@@ -0,0 +1,133 @@
+/**
+ * @file prom_columns.h
+ * @brief Représentation en colonnes d’une promotion pour les parcours de classement et de statistiques.
+ *
+ * `Prom` est une structure d’objets : chaque étudiant, chaque inscription et chaque
+ * tableau de notes est une allocation distincte, et un parcours de la promotion suit
+ * plusieurs niveaux de pointeurs. `PromColumns` range les mêmes données dans des
+ * tableaux denses :
+ * - un tableau par attribut d’étudiant (`student_ids`, `ages`, `general_averages`) ;
+ * - une matrice étudiants × cours des moyennes, stockée cours par cours, pour que
+ *   les statistiques d’un cours lisent une zone contiguë ;
+ * - toutes les notes dans un seul tableau, indexé par des décalages au format CSR ;
+ * - les cours notés de chaque étudiant dans l’ordre de ses inscriptions, rang par
+ *   rang, pour cumuler les moyennes générales dans le même ordre que la promotion.
+ *
+ * La ligne `i` des colonnes correspond à `promo->students[i]` et la colonne `c` au
+ * cours `c` du catalogue. Les colonnes sont une copie : elles ne suivent pas les
+ * modifications ultérieures de la promotion.
+ *
+ * @see struct.h
+ */
+
+#ifndef PROM_COLUMNS_H
+#define PROM_COLUMNS_H
+
+#include "./struct.h"
+
+/**
+ * @struct PromColumns
+ * @brief Promotion stockée par colonnes.
+ *
+ * Pour l’étudiant `i` et le cours `c`, avec `cell = c * num_students + i` :
+ * - `course_averages[cell]` est la moyenne de l’étudiant dans le cours (0 s’il n’y est pas inscrit) ;
+ * - ses notes sont `grades[grade_offsets[cell]]` à `grades[grade_offsets[cell + 1] - 1]`,
+ *   dans l’ordre de saisie ; un couple sans note n’est pas une inscription ;
+ * - `enrollment_courses[r * num_students + i]` est son `r`-ième cours noté (-1 au-delà).
+ */
+typedef struct PromColumns {
+    int num_students;         /**< Nombre d’étudiants (lignes). */
+    int num_courses;          /**< Nombre de cours du catalogue (colonnes). */
+    int num_grades;           /**< Nombre total de notes. */
+    int* student_ids;         /**< Numéro de chaque étudiant. */
+    int* ages;                /**< Âge de chaque étudiant. */
+    float* general_averages;  /**< Moyenne générale de chaque étudiant. */
+    float* course_coeffs;     /**< Coefficient de chaque cours. */
+    float* course_averages;   /**< Moyennes, `num_courses` × `num_students`, cours par cours. */
+    int* grade_offsets;       /**< Décalages CSR des notes, `num_courses` × `num_students` + 1 entrées. */
+    uint8_t* grades;          /**< Toutes les notes en dixièmes de point, cours par cours puis étudiant par étudiant. */
+    int max_enrollments;      /**< Plus grand nombre de cours notés d’un étudiant. */
+    int* enrollment_courses;  /**< Cours notés de chaque étudiant, `max_enrollments` × `num_students`, rang par rang. */
+} PromColumns;
+
+/**
+ * @brief Construit la représentation en colonnes d’une promotion chargée.
+ *
+ * @param p Promotion source (non modifiée).
+ * @return Les colonnes allouées dynamiquement, ou NULL en cas d’erreur (dont une
+ *         promotion chargée avec `LOAD_AGGREGATE_ONLY`, qui n’a pas les notes, et une
+ *         matrice étudiants × cours d’au moins 2³¹ cases).
+ *
+ * @note Les colonnes doivent être libérées avec `destroyPromColumns()`.
+ */
+PromColumns* createPromColumns(const Prom* p);
+
+/**
+ * @brief Charge directement un fichier texte sous forme de colonnes.
+ *
+ * La promotion intermédiaire est chargée dans une arène puis libérée en une fois
+ * dès que les colonnes sont construites.
+ *
+ * @param filename Nom du fichier texte à charger.
+ * @param flags    Options de chargement (voir `loadPromotionFromFileEx()`).
+ * @return Les colonnes allouées dynamiquement, ou NULL en cas d’erreur.
+ */
+PromColumns* loadPromColumnsFromFile(char* filename, int flags);
+
+/**
+ * @brief Libère toutes les colonnes.
+ *
+ * @param cols Colonnes à libérer (NULL accepté).
+ */
+void destroyPromColumns(PromColumns* cols);
+
+/**
+ * @brief Retourne les `k` meilleures moyennes générales, en ne lisant que la colonne des moyennes.
+ *
+ * À moyenne égale, l’étudiant le plus tôt dans la promotion passe en premier.
+ *
+ * @param cols Colonnes de la promotion.
+ * @param k    Nombre d’étudiants demandés.
+ * @param rows Tableau d’au moins `k` entiers, rempli avec les lignes des étudiants classés.
+ * @return Le nombre de lignes écrites (≤ k).
+ */
+int getTopStudentsColumns(const PromColumns* cols, int k, int* rows);
+
+/**
+ * @brief Calcule la moyenne d’un cours sur les étudiants inscrits.
+ *
+ * @param cols         Colonnes de la promotion.
+ * @param course_index Indice du cours dans le catalogue.
+ * @param count        Nombre d’étudiants inscrits au cours (peut être NULL).
+ * @return La moyenne des moyennes des inscrits, ou 0 si aucun.
+ */
+float getCourseMeanColumns(const PromColumns* cols, int course_index, int* count);
+
+/**
+ * @brief Recalcule toutes les moyennes de cours et toutes les moyennes générales à partir des notes.
+ *
+ * Sommes des notes, moyennes des cases puis moyennes générales pondérées sont
+ * calculées par les noyaux vectoriels de `grade_kernels.h`, colonne par colonne.
+ * Les moyennes de cours sont identiques à celles de `gradesAverage()` et les
+ * moyennes générales à celles de `updateGeneralAverage()` (cumul en `float` dans
+ * l’ordre des inscriptions) : sur des colonnes que rien n’a modifiées, elles
+ * sont recalculées au bit près.
+ *
+ * @param cols Colonnes de la promotion.
+ * @return 0 si succès, -1 en cas d’erreur d’allocation ou d’argument invalide.
+ */
+int refreshColumnsAverages(PromColumns* cols);
+
+/**
+ * @brief Modifie le coefficient d’un cours et recalcule toutes les moyennes générales.
+ *
+ * Seule la pondération change : les moyennes de cours ne sont pas recalculées.
+ *
+ * @param cols         Colonnes de la promotion.
+ * @param course_index Indice du cours dans le catalogue.
+ * @param coeff        Nouveau coefficient.
+ * @return 0 si succès, -1 si l’indice est invalide ou en cas d’erreur d’allocation.
+ */
+int setCourseCoeffColumns(PromColumns* cols, int course_index, float coeff);
+
+#endif // PROM_COLUMNS_H
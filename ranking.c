@@ -0,0 +1,176 @@
+/**
+ * @file ranking.c
+ * @brief Tri par base des moyennes générales et requêtes de rang d’une promotion.
+ *
+ * @see ranking.h
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "./ranking.h"
+#include "./struct_functions.h"
+
+/**
+ * @brief Clé 32 bits dont l’ordre entier non signé est l’ordre décroissant des moyennes.
+ *
+ * Les flottants positifs se comparent comme leur représentation une fois le bit de
+ * signe mis à 1 ; les négatifs, une fois tous les bits inversés. La clé est ensuite
+ * inversée pour classer la meilleure moyenne en premier.
+ */
+static uint32_t descendingKey(float average) {
+    uint32_t bits;
+    memcpy(&bits, &average, sizeof(bits));
+    bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    return ~bits;
+}
+
+/**
+ * @brief Trie des couples (clé, position) sur la clé, stockée dans les 32 bits de poids fort.
+ */
+uint64_t* radixSortKeys(uint64_t* items, uint64_t* tmp, int n) {
+    if (n <= 0)
+        return items;
+    for (int shift = 32; shift < 64; shift += 8) {
+        int offsets[256] = { 0 };
+        for (int i = 0; i < n; i++)
+            offsets[(items[i] >> shift) & 0xFF]++;
+        if (offsets[(items[0] >> shift) & 0xFF] == n)
+            continue;
+
+        int total = 0;
+        for (int b = 0; b < 256; b++) {
+            int c = offsets[b];
+            offsets[b] = total;
+            total += c;
+        }
+        for (int i = 0; i < n; i++)
+            tmp[offsets[(items[i] >> shift) & 0xFF]++] = items[i];
+
+        uint64_t* swap = items;
+        items = tmp;
+        tmp = swap;
+    }
+    return items;
+}
+
+/**
+ * @brief Trie tous les étudiants d’une promotion par moyenne générale décroissante.
+ */
+Ranking* createRanking(const Prom* promo) {
+    if (promo == NULL || promo->num_students < 0)
+        return NULL;
+
+    int n = promo->num_students;
+    Ranking* r = calloc(1, sizeof(Ranking));
+    if (r == NULL)
+        return NULL;
+    r->promo = promo;
+    r->size = n;
+    if (n == 0)
+        return r;
+
+    r->order = malloc(sizeof(Student*) * n);
+    r->ranks = malloc(sizeof(int) * n);
+    r->ties = malloc(sizeof(int) * n);
+    uint64_t* items = malloc(sizeof(uint64_t) * n);
+    uint64_t* tmp = malloc(sizeof(uint64_t) * n);
+    if (r->order == NULL || r->ranks == NULL || r->ties == NULL || items == NULL || tmp == NULL) {
+        free(items);
+        free(tmp);
+        destroyRanking(r);
+        return NULL;
+    }
+
+    for (int i = 0; i < n; i++)
+        items[i] = (uint64_t)descendingKey(promo->students[i]->general_average) << 32 | (uint32_t)i;
+    uint64_t* sorted = radixSortKeys(items, tmp, n);
+
+    for (int i = 0; i < n; i++)
+        r->order[i] = promo->students[(uint32_t)sorted[i]];
+
+    // Groupes d’ex æquo : même rang, et taille du groupe pour le centile
+    int first = 0;
+    for (int i = 1; i <= n; i++) {
+        if (i < n && r->order[i]->general_average == r->order[first]->general_average)
+            continue;
+        for (int j = first; j < i; j++) {
+            int position = (int)(uint32_t)sorted[j];
+            r->ranks[position] = first + 1;
+            r->ties[position] = i - first;
+        }
+        first = i;
+    }
+
+    free(items);
+    free(tmp);
+    return r;
+}
+
+/**
+ * @brief Libère un classement.
+ */
+void destroyRanking(Ranking* r) {
+    if (r == NULL)
+        return;
+    free(r->order);
+    free(r->ranks);
+    free(r->ties);
+    free(r);
+}
+
+/**
+ * @brief Position d’un étudiant classé, ou -1.
+ */
+static int rankedPosition(const Ranking* r, int id) {
+    if (r == NULL)
+        return -1;
+    int position = findStudentPosition(r->promo, id);
+    if (position < 0 || position >= r->size)
+        return -1;
+    return position;
+}
+
+/**
+ * @brief Rang d’un étudiant dans la promotion.
+ */
+int getStudentRank(const Ranking* r, int id) {
+    int position = rankedPosition(r, id);
+    if (position == -1)
+        return -1;
+    return r->ranks[position];
+}
+
+/**
+ * @brief Centile d’un étudiant.
+ */
+float getPercentile(const Ranking* r, int id) {
+    int position = rankedPosition(r, id);
+    if (position == -1)
+        return -1.0f;
+
+    int ties = r->ties[position];
+    int below = r->size - (r->ranks[position] - 1) - ties;
+    return (float)(100.0 * (below + 0.5 * ties) / r->size);
+}
+
+/**
+ * @brief Extrait les étudiants classés entre deux places du classement.
+ */
+int getStudentsInRankRange(const Ranking* r, int lo, int hi, Student** out, int* count) {
+    if (count != NULL)
+        *count = 0;
+    if (r == NULL || out == NULL || count == NULL)
+        return -1;
+
+    if (lo < 1)
+        lo = 1;
+    if (hi > r->size)
+        hi = r->size;
+    if (lo > hi)
+        return 0;
+
+    memcpy(out, &r->order[lo - 1], sizeof(Student*) * (hi - lo + 1));
+    *count = hi - lo + 1;
+    return 0;
+}
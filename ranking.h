@@ -0,0 +1,108 @@
+/**
+ * @file ranking.h
+ * @brief Classement complet d’une promotion : rang, centile et tranches de rangs.
+ *
+ * `createRanking()` trie tous les étudiants par moyenne générale décroissante avec
+ * un tri par base (LSD, 8 bits par passe) sur la représentation binaire de la
+ * moyenne, rendue croissante avec l’ordre des flottants : pas de fonction de
+ * comparaison ni d’appel indirect, et des passes séquentielles sur un tableau dense.
+ * À moyenne égale, l’étudiant le plus tôt dans la promotion passe en premier.
+ *
+ * Le classement est une photographie : il doit être reconstruit si la promotion
+ * est modifiée (pour les `k` premiers tenus à jour, voir `leaderboard.h`).
+ *
+ * @see file_sorting.h
+ */
+
+#ifndef RANKING_H
+#define RANKING_H
+
+#include <stdint.h>
+#include "./struct.h"
+
+/**
+ * @struct Ranking
+ * @brief Étudiants d’une promotion triés par moyenne générale, avec le rang de chacun.
+ */
+typedef struct Ranking {
+    const Prom* promo;      /**< Promotion classée. */
+    Student** order;        /**< Étudiants du meilleur au moins bon. */
+    int* ranks;             /**< Rang de chaque étudiant, indexé par position dans la promotion (ex æquo : même rang). */
+    int* ties;              /**< Nombre d’étudiants partageant la moyenne de chacun, indexé par position. */
+    int size;               /**< Nombre d’étudiants classés. */
+} Ranking;
+
+/**
+ * @brief Trie tous les étudiants d’une promotion par moyenne générale décroissante.
+ *
+ * Coût O(n) (au plus 4 passes de tri par base), plus deux tableaux temporaires de n entiers 64 bits.
+ *
+ * @param promo Pointeur vers la promotion.
+ * @return Le classement, ou NULL en cas d’erreur d’allocation ou d’argument invalide.
+ *
+ * @note Le classement doit être libéré avec `destroyRanking()`, avant la promotion.
+ */
+Ranking* createRanking(const Prom* promo);
+
+/**
+ * @brief Libère un classement.
+ *
+ * @param r Classement à libérer (peut être NULL).
+ */
+void destroyRanking(Ranking* r);
+
+/**
+ * @brief Rang d’un étudiant dans la promotion.
+ *
+ * Les ex æquo partagent le même rang, qui est 1 + le nombre d’étudiants ayant une
+ * meilleure moyenne (rangs 1, 2, 2, 4…).
+ *
+ * @param r  Classement.
+ * @param id Identifiant de l’étudiant.
+ * @return Le rang (1 pour le meilleur), ou -1 si l’étudiant n’est pas classé.
+ */
+int getStudentRank(const Ranking* r, int id);
+
+/**
+ * @brief Centile d’un étudiant : part de la promotion dont la moyenne est inférieure à la sienne.
+ *
+ * Les ex æquo comptent pour moitié, si bien qu’une promotion où tous ont la même
+ * moyenne place chacun au 50e centile.
+ *
+ * @param r  Classement.
+ * @param id Identifiant de l’étudiant.
+ * @return Le centile entre 0 et 100, ou -1 si l’étudiant n’est pas classé.
+ */
+float getPercentile(const Ranking* r, int id);
+
+/**
+ * @brief Extrait les étudiants classés entre deux places du classement, bornes comprises.
+ *
+ * Les places sont celles de `Ranking.order` (de 1 à `size`, sans ex æquo) ; les
+ * bornes sont ramenées dans cet intervalle. `getStudentsInRankRange(r, 1, r->size, ...)`
+ * exporte toute la promotion triée.
+ *
+ * @param r     Classement.
+ * @param lo    Première place (1 pour le meilleur).
+ * @param hi    Dernière place.
+ * @param out   Tableau d’au moins `hi - lo + 1` pointeurs.
+ * @param count Pointeur vers un entier où sera stocké le nombre d’étudiants écrits.
+ * @return 0 si succès, -1 si un argument est invalide.
+ */
+int getStudentsInRankRange(const Ranking* r, int lo, int hi, Student** out, int* count);
+
+/**
+ * @brief Trie des couples (clé, position) sur la clé, stockée dans les 32 bits de poids fort.
+ *
+ * Tri par base stable, 8 bits par passe : à clé égale, l’ordre des positions (32 bits
+ * de poids faible) est conservé. Une passe dont tous les éléments tombent dans le même
+ * paquet est sautée : des clés de moins de 24 bits ne coûtent que 1 à 3 passes.
+ *
+ * @param items Couples à trier.
+ * @param tmp   Tableau temporaire de même taille.
+ * @param n     Nombre de couples.
+ * @return Le tableau (`items` ou `tmp`) qui contient le résultat.
+ */
+uint64_t* radixSortKeys(uint64_t* items, uint64_t* tmp, int n);
+
+#endif // RANKING_H
@@ -0,0 +1,430 @@
+/**
+ * @file report.c
+ * @brief Mise en forme des rapports dans un tampon unique, nombres écrits sans `printf`.
+ *
+ * @see report.h
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "./report.h"
+
+/** @brief Place réservée pour un nombre, quel qu’il soit (y compris `%.2f` d’un très grand flottant). */
+#define REPORT_NUMBER_SIZE 64
+
+/** @brief Tampon de secours, sur la pile, si le grand tampon ne peut pas être alloué. */
+#define REPORT_FALLBACK_SIZE 4096
+
+/** @brief Ajoute une chaîne littérale au rapport. */
+#define PUT_LITERAL(w, s) putBytes((w), (s), sizeof(s) - 1)
+
+/**
+ * @struct ReportWriter
+ * @brief Tampon de sortie vidé par `write()`.
+ */
+typedef struct ReportWriter {
+    int fd;                 /**< Descripteur de destination. */
+    char* buffer;           /**< Tampon de mise en forme. */
+    size_t size;            /**< Octets en attente dans le tampon. */
+    size_t capacity;        /**< Taille du tampon. */
+    int failed;             /**< Vrai après une erreur d’écriture : la suite est ignorée. */
+} ReportWriter;
+
+/**
+ * @brief Écrit le contenu du tampon, en reprenant les écritures partielles.
+ */
+static void flushReport(ReportWriter* w) {
+    size_t done = 0;
+    while (done < w->size && !w->failed) {
+        ssize_t n = write(w->fd, w->buffer + done, w->size - done);
+        if (n >= 0)
+            done += (size_t)n;
+        else if (errno != EINTR)
+            w->failed = 1;
+    }
+    w->size = 0;
+}
+
+/**
+ * @brief Garantit `n` octets libres dans le tampon (`n` ≤ `REPORT_NUMBER_SIZE`).
+ * @return La position d’écriture.
+ */
+static char* reserveReport(ReportWriter* w, size_t n) {
+    if (w->capacity - w->size < n)
+        flushReport(w);
+    return w->buffer + w->size;
+}
+
+/**
+ * @brief Ajoute `n` octets au rapport, en vidant le tampon autant de fois que nécessaire.
+ */
+static void putBytes(ReportWriter* w, const char* src, size_t n) {
+    while (n > 0) {
+        if (w->size == w->capacity)
+            flushReport(w);
+        size_t part = w->capacity - w->size;
+        if (part > n)
+            part = n;
+        memcpy(w->buffer + w->size, src, part);
+        w->size += part;
+        src += part;
+        n -= part;
+    }
+}
+
+/**
+ * @brief Ajoute un caractère au rapport.
+ */
+static void putChar(ReportWriter* w, char c) {
+    *reserveReport(w, 1) = c;
+    w->size++;
+}
+
+/**
+ * @brief Ajoute un entier en base 10.
+ */
+static void putInt(ReportWriter* w, long long value) {
+    char digits[24];
+    int n = 0;
+    unsigned long long u = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+    do {
+        digits[n++] = (char)('0' + u % 10);
+        u /= 10;
+    } while (u > 0);
+
+    char* out = reserveReport(w, (size_t)n + 1);
+    if (value < 0)
+        *out++ = '-';
+    while (n > 0)
+        *out++ = digits[--n];
+    w->size = (size_t)(out - w->buffer);
+}
+
+/**
+ * @brief Ajoute un flottant avec `decimals` chiffres après la virgule (1 ou 2), comme `printf("%.*f")`.
+ *
+ * Un `float` a 24 bits de mantisse : multiplié par 10 ou 100 (7 bits au plus), il
+ * reste exact en double. La partie fractionnaire restante est donc exacte, et
+ * l’arrondi au plus proche, à égalité vers le pair, est celui de `printf`. Les
+ * valeurs non finies ou trop grandes pour un entier 64 bits passent par `snprintf()`.
+ */
+static void putFixed(ReportWriter* w, float value, int decimals) {
+    double v = value;
+    double scale = (decimals == 1) ? 10.0 : 100.0;
+    char* out = reserveReport(w, REPORT_NUMBER_SIZE);
+
+    if (!(v > -1e15 && v < 1e15)) {
+        int n = snprintf(out, REPORT_NUMBER_SIZE, "%.*f", decimals, v);
+        w->size += (n > 0 && n < REPORT_NUMBER_SIZE) ? (size_t)n : 0;
+        return;
+    }
+
+    if (signbit(v)) {
+        *out++ = '-';
+        v = -v;
+    }
+    double scaled = v * scale;
+    unsigned long long r = (unsigned long long)scaled;
+    double frac = scaled - (double)r;
+    if (frac > 0.5 || (frac == 0.5 && (r & 1)))
+        r++;
+
+    char digits[24];
+    int n = 0;
+    for (int d = 0; d < decimals; d++) {
+        digits[n++] = (char)('0' + r % 10);
+        r /= 10;
+    }
+    digits[n++] = '.';
+    do {
+        digits[n++] = (char)('0' + r % 10);
+        r /= 10;
+    } while (r > 0);
+
+    while (n > 0)
+        *out++ = digits[--n];
+    w->size = (size_t)(out - w->buffer);
+}
+
+/**
+ * @brief Ajoute une note en dixièmes, comme `printf("%.1f", tenthsToGrade(tenths))`.
+ */
+static void putTenths(ReportWriter* w, int tenths) {
+    char* out = reserveReport(w, 4);
+    if (tenths >= 100)
+        *out++ = (char)('0' + tenths / 100);
+    *out++ = (char)('0' + tenths / 10 % 10);
+    *out++ = '.';
+    *out++ = (char)('0' + tenths % 10);
+    w->size = (size_t)(out - w->buffer);
+}
+
+/**
+ * @brief Ajoute un champ CSV, entre guillemets s’il contient un séparateur, un guillemet ou une fin de ligne.
+ */
+static void putCsvField(ReportWriter* w, const char* s, size_t length) {
+    if (strcspn(s, ",\"\r\n") >= length) {
+        putBytes(w, s, length);
+        return;
+    }
+    putChar(w, '"');
+    for (size_t i = 0; i < length; i++) {
+        if (s[i] == '"')
+            putChar(w, '"');
+        putChar(w, s[i]);
+    }
+    putChar(w, '"');
+}
+
+/**
+ * @brief Ajoute une chaîne JSON, guillemets et échappements compris.
+ */
+static void putJsonString(ReportWriter* w, const char* s, size_t length) {
+    static const char hex[] = "0123456789abcdef";
+
+    putChar(w, '"');
+    size_t start = 0;
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)s[i];
+        if (c >= 0x20 && c != '"' && c != '\\')
+            continue;
+        putBytes(w, s + start, i - start);
+        start = i + 1;
+        if (c == '"' || c == '\\') {
+            putChar(w, '\\');
+            putChar(w, (char)c);
+        } else if (c == '\n') {
+            PUT_LITERAL(w, "\\n");
+        } else if (c == '\t') {
+            PUT_LITERAL(w, "\\t");
+        } else if (c == '\r') {
+            PUT_LITERAL(w, "\\r");
+        } else {
+            PUT_LITERAL(w, "\\u00");
+            putChar(w, hex[c >> 4]);
+            putChar(w, hex[c & 0xF]);
+        }
+    }
+    putBytes(w, s + start, length - start);
+    putChar(w, '"');
+}
+
+/**
+ * @brief Ajoute un nombre JSON : `null` pour une valeur non finie, que JSON ne représente pas.
+ */
+static void putJsonNumber(ReportWriter* w, float value) {
+    if (isfinite(value))
+        putFixed(w, value, 2);
+    else
+        PUT_LITERAL(w, "null");
+}
+
+/**
+ * @brief Ajoute un nom (prénom ou nom de famille) dans le format du rapport.
+ */
+static void putName(ReportWriter* w, const char* name, int format) {
+    if (format == REPORT_CSV)
+        putCsvField(w, name, strlen(name));
+    else if (format == REPORT_JSONL)
+        putJsonString(w, name, strlen(name));
+    else
+        putBytes(w, name, strlen(name));
+}
+
+/**
+ * @brief Bloc d’un étudiant au format texte, identique à celui de `printPromotion()`.
+ */
+static void writeStudentText(ReportWriter* w, const Prom* p, const Student* s) {
+    PUT_LITERAL(w, "\n");
+    putInt(w, s->student_id);
+    PUT_LITERAL(w, " - ");
+    putName(w, s->first_name, REPORT_TEXT);
+    putChar(w, ' ');
+    putName(w, s->last_name, REPORT_TEXT);
+    PUT_LITERAL(w, ", ");
+    putInt(w, s->age);
+    PUT_LITERAL(w, " ans\nMoyenne générale : ");
+    putFixed(w, s->general_average, 2);
+    putChar(w, '\n');
+
+    for (int j = 0; j < s->num_courses; j++) {
+        const Enrollment* e = &s->courses[j];
+        const Course* c = &p->courses[e->course_index];
+        PUT_LITERAL(w, "  ");
+        putBytes(w, c->course_name, (size_t)c->name_length);
+        PUT_LITERAL(w, " (coeff ");
+        putFixed(w, c->coeff, 2);
+        PUT_LITERAL(w, ") - Moy: ");
+        putFixed(w, e->average, 2);
+        PUT_LITERAL(w, " - Notes: ");
+        if (p->aggregate_only && e->grades.size > 0) {
+            putInt(w, e->grades.size);
+            PUT_LITERAL(w, " notes (min ");
+            putTenths(w, e->grades.min);
+            PUT_LITERAL(w, ", max ");
+            putTenths(w, e->grades.max);
+            putChar(w, ')');
+        }
+        for (int k = 0; k < e->grades.size && !p->aggregate_only; k++) {
+            putTenths(w, e->grades.grades_array[k]);
+            putChar(w, ' ');
+        }
+        putChar(w, '\n');
+    }
+}
+
+/**
+ * @brief Colonnes d’un étudiant communes à toutes ses lignes CSV.
+ */
+static void writeStudentCsvPrefix(ReportWriter* w, const Student* s) {
+    putInt(w, s->student_id);
+    putChar(w, ',');
+    putName(w, s->first_name, REPORT_CSV);
+    putChar(w, ',');
+    putName(w, s->last_name, REPORT_CSV);
+    putChar(w, ',');
+    putInt(w, s->age);
+    putChar(w, ',');
+    putFixed(w, s->general_average, 2);
+    putChar(w, ',');
+}
+
+/**
+ * @brief Lignes CSV d’un étudiant : une par inscription.
+ */
+static void writeStudentCsv(ReportWriter* w, const Prom* p, const Student* s) {
+    if (s->num_courses == 0) {
+        writeStudentCsvPrefix(w, s);
+        PUT_LITERAL(w, ",,,0,\n");
+        return;
+    }
+
+    for (int j = 0; j < s->num_courses; j++) {
+        const Enrollment* e = &s->courses[j];
+        const Course* c = &p->courses[e->course_index];
+        writeStudentCsvPrefix(w, s);
+        putCsvField(w, c->course_name, (size_t)c->name_length);
+        putChar(w, ',');
+        putFixed(w, c->coeff, 2);
+        putChar(w, ',');
+        putFixed(w, e->average, 2);
+        putChar(w, ',');
+        putInt(w, e->grades.size);
+        putChar(w, ',');
+        for (int k = 0; k < e->grades.size && !p->aggregate_only; k++) {
+            if (k > 0)
+                putChar(w, ' ');
+            putTenths(w, e->grades.grades_array[k]);
+        }
+        putChar(w, '\n');
+    }
+}
+
+/**
+ * @brief Ligne JSON d’un étudiant, avec ses inscriptions.
+ */
+static void writeStudentJson(ReportWriter* w, const Prom* p, const Student* s) {
+    PUT_LITERAL(w, "{\"student_id\":");
+    putInt(w, s->student_id);
+    PUT_LITERAL(w, ",\"first_name\":");
+    putName(w, s->first_name, REPORT_JSONL);
+    PUT_LITERAL(w, ",\"last_name\":");
+    putName(w, s->last_name, REPORT_JSONL);
+    PUT_LITERAL(w, ",\"age\":");
+    putInt(w, s->age);
+    PUT_LITERAL(w, ",\"general_average\":");
+    putJsonNumber(w, s->general_average);
+    PUT_LITERAL(w, ",\"courses\":[");
+
+    for (int j = 0; j < s->num_courses; j++) {
+        const Enrollment* e = &s->courses[j];
+        const Course* c = &p->courses[e->course_index];
+        if (j > 0)
+            putChar(w, ',');
+        PUT_LITERAL(w, "{\"course\":");
+        putJsonString(w, c->course_name, (size_t)c->name_length);
+        PUT_LITERAL(w, ",\"coeff\":");
+        putJsonNumber(w, c->coeff);
+        PUT_LITERAL(w, ",\"average\":");
+        putJsonNumber(w, e->average);
+        PUT_LITERAL(w, ",\"grade_count\":");
+        putInt(w, e->grades.size);
+        if (p->aggregate_only) {
+            if (e->grades.size > 0) {
+                PUT_LITERAL(w, ",\"min\":");
+                putTenths(w, e->grades.min);
+                PUT_LITERAL(w, ",\"max\":");
+                putTenths(w, e->grades.max);
+            }
+        } else {
+            PUT_LITERAL(w, ",\"grades\":[");
+            for (int k = 0; k < e->grades.size; k++) {
+                if (k > 0)
+                    putChar(w, ',');
+                putTenths(w, e->grades.grades_array[k]);
+            }
+            putChar(w, ']');
+        }
+        putChar(w, '}');
+    }
+    PUT_LITERAL(w, "]}\n");
+}
+
+/**
+ * @brief Écrit le rapport d’une promotion sur un descripteur de fichier.
+ */
+int writeReport(int fd, const Prom* p, int format) {
+    if (p == NULL || fd < 0 || format < REPORT_TEXT || format > REPORT_JSONL)
+        return -1;
+
+    char fallback[REPORT_FALLBACK_SIZE];
+    ReportWriter w = { fd, malloc(REPORT_BUFFER_SIZE), 0, REPORT_BUFFER_SIZE, 0 };
+    if (w.buffer == NULL) {
+        w.buffer = fallback;
+        w.capacity = sizeof(fallback);
+    }
+
+    if (format == REPORT_CSV)
+        PUT_LITERAL(&w, "student_id,first_name,last_name,age,general_average,"
+                        "course,coeff,course_average,grade_count,grades\n");
+
+    for (int i = 0; i < p->num_students && !w.failed; i++) {
+        const Student* s = p->students[i];
+        if (format == REPORT_CSV)
+            writeStudentCsv(&w, p, s);
+        else if (format == REPORT_JSONL)
+            writeStudentJson(&w, p, s);
+        else
+            writeStudentText(&w, p, s);
+    }
+    flushReport(&w);
+
+    if (w.buffer != fallback)
+        free(w.buffer);
+    return w.failed ? -1 : 0;
+}
+
+/**
+ * @brief Écrit le rapport d’une promotion dans un fichier, créé ou remplacé.
+ */
+int saveReport(const char* filename, const Prom* p, int format) {
+    if (filename == NULL || p == NULL)
+        return -1;
+
+    int fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
+        fprintf(stderr, "Erreur : ouverture du fichier %s impossible.\n", filename);
+        return -1;
+    }
+    int status = writeReport(fd, p, format);
+    if (close(fd) == -1)
+        status = -1;
+    return status;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file report.h
+ * @brief Export d’une promotion en texte, CSV ou JSON Lines, par un tampon unique et de gros `write`.
+ *
+ * Le rapport est mis en forme dans un tampon de `REPORT_BUFFER_SIZE` octets,
+ * réutilisé du début à la fin et vidé par des appels directs à `write()` : ni
+ * `printf` par note, ni verrou de `stdio`. Les nombres sont écrits à la main,
+ * avec le même arrondi que `printf` (`%.2f` pour les moyennes et coefficients,
+ * `%.1f` pour les notes), si bien que le format texte est identique, octet pour
+ * octet, à l’affichage historique.
+ *
+ * Formats :
+ * - `REPORT_TEXT` : blocs par étudiant de `printPromotion()` (sans l’en-tête) ;
+ * - `REPORT_CSV` : une ligne par inscription (une ligne aux champs de matière vides
+ *   pour un étudiant sans inscription), notes séparées par des espaces dans la
+ *   dernière colonne ;
+ * - `REPORT_JSONL` : un objet JSON par étudiant et par ligne, avec ses inscriptions.
+ *
+ * Pour une promotion chargée avec `LOAD_AGGREGATE_ONLY`, le nombre de notes et leurs
+ * extrêmes remplacent la liste des notes.
+ *
+ * @see file_gestion.h
+ */
+
+#ifndef REPORT_H
+#define REPORT_H
+
+#include "./struct.h"
+
+/** @brief Taille du tampon de mise en forme (1 Mio). */
+#define REPORT_BUFFER_SIZE (1 << 20)
+
+/** @brief Format texte, celui de `printPromotion()`. */
+#define REPORT_TEXT 0
+
+/** @brief Format CSV (RFC 4180), avec une ligne d’en-tête. */
+#define REPORT_CSV 1
+
+/** @brief Format JSON Lines : un objet par étudiant. */
+#define REPORT_JSONL 2
+
+/**
+ * @brief Écrit le rapport d’une promotion sur un descripteur de fichier.
+ *
+ * @param fd     Descripteur ouvert en écriture.
+ * @param p      Pointeur vers la promotion.
+ * @param format `REPORT_TEXT`, `REPORT_CSV` ou `REPORT_JSONL`.
+ * @return 0 si succès, -1 si un argument est invalide ou en cas d’erreur d’écriture.
+ *
+ * @note Un flux `stdio` sur le même descripteur (`stdout`…) doit être vidé avec
+ *       `fflush()` avant l’appel.
+ */
+int writeReport(int fd, const Prom* p, int format);
+
+/**
+ * @brief Écrit le rapport d’une promotion dans un fichier, créé ou remplacé.
+ *
+ * @param filename Nom du fichier de destination.
+ * @param p        Pointeur vers la promotion.
+ * @param format   `REPORT_TEXT`, `REPORT_CSV` ou `REPORT_JSONL`.
+ * @return 0 si succès, -1 en cas d’erreur.
+ */
+int saveReport(const char* filename, const Prom* p, int format);
+
+#endif // REPORT_H
@@ -0,0 +1,743 @@
+/**
+ * @file snapshot.c
+ * @brief Écriture, ouverture par projection mémoire et lecture en place des snapshots.
+ *
+ * @see snapshot.h
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "./snapshot.h"
+#include "./crc32c.h"
+#include "./struct_functions.h"
+#include "./file_gestion.h"
+
+/** @brief Nombre de sections écrites par `saveSnapshot()`. */
+#define SNAPSHOT_NUM_SECTIONS 8
+
+/** @brief Nombre maximal d’entrées acceptées dans la table des sections. */
+#define SNAPSHOT_MAX_SECTIONS 64
+
+/**
+ * @brief Indique si la machine range les entiers en little-endian (ordre du format).
+ */
+static int hostIsLittleEndian(void) {
+    const uint16_t probe = 1;
+    return *(const unsigned char*)&probe == 1;
+}
+
+/**
+ * @brief Arrondit une taille au multiple de 8 supérieur.
+ */
+static uint64_t align8(uint64_t n) {
+    return (n + 7) & ~(uint64_t)7;
+}
+
+/**
+ * @brief Nombre de blocs de `SNAPSHOT_CRC_BLOCK` octets d’une section.
+ */
+static uint64_t blockCount(uint64_t size) {
+    return (size + SNAPSHOT_CRC_BLOCK - 1) / SNAPSHOT_CRC_BLOCK;
+}
+
+/**
+ * @brief Indique si une section est couverte par les sommes de contrôle par bloc.
+ */
+static int hasBlockCrcs(uint32_t id) {
+    return id >= SNAPSHOT_SECTION_STUDENTS && id <= SNAPSHOT_SECTION_JOURNAL;
+}
+
+/**
+ * @brief Compare deux entrées de l’index des numéros (numéro, puis position).
+ */
+static int compareIndexEntries(const void* a, const void* b) {
+    const SnapshotIndexEntry* ea = a;
+    const SnapshotIndexEntry* eb = b;
+    if (ea->student_id != eb->student_id)
+        return (ea->student_id < eb->student_id) ? -1 : 1;
+    return (ea->position < eb->position) ? -1 : (ea->position > eb->position);
+}
+
+/**
+ * @brief Écrit une promotion au format snapshot.
+ */
+int saveSnapshot(const char* filename, const Prom* p) {
+    return saveSnapshotWithGeneration(filename, p, 0);
+}
+
+/**
+ * @brief Écrit une promotion au format snapshot en indiquant la génération du journal associé.
+ */
+int saveSnapshotWithGeneration(const char* filename, const Prom* p, uint64_t journal_generation) {
+    if (filename == NULL || p == NULL) {
+        fprintf(stderr, "Erreur : arguments invalides.\n");
+        return -1;
+    }
+    if (!hostIsLittleEndian()) {
+        fprintf(stderr, "Erreur : format snapshot non pris en charge sur cette machine.\n");
+        return -1;
+    }
+    if (p->aggregate_only) {
+        fprintf(stderr, "Erreur : promotion chargée sans ses notes, sauvegarde impossible.\n");
+        return -1;
+    }
+
+    // Taille de chaque section
+    uint64_t nb_enrollments = 0, nb_grades = 0, strings_size = 0;
+    for (int i = 0; i < p->num_students; i++) {
+        const Student* s = p->students[i];
+        strings_size += strlen(s->first_name) + 1 + strlen(s->last_name) + 1;
+        nb_enrollments += s->num_courses;
+        for (int j = 0; j < s->num_courses; j++)
+            nb_grades += s->courses[j].grades.size;
+    }
+    for (int c = 0; c < p->num_courses; c++)
+        strings_size += p->courses[c].name_length + 1;
+
+    if (nb_enrollments > UINT32_MAX || nb_grades > UINT32_MAX || strings_size > UINT32_MAX) {
+        fprintf(stderr, "Erreur : promotion trop grande pour le format snapshot.\n");
+        return -1;
+    }
+
+    SnapshotSection sections[SNAPSHOT_NUM_SECTIONS] = {
+        { SNAPSHOT_SECTION_STUDENTS, 0, 0, (uint64_t)p->num_students * sizeof(SnapshotStudent), (uint64_t)p->num_students },
+        { SNAPSHOT_SECTION_COURSES, 0, 0, (uint64_t)p->num_courses * sizeof(SnapshotCourse), (uint64_t)p->num_courses },
+        { SNAPSHOT_SECTION_ENROLLMENTS, 0, 0, nb_enrollments * sizeof(SnapshotEnrollment), nb_enrollments },
+        { SNAPSHOT_SECTION_GRADES, 0, 0, nb_grades * sizeof(uint8_t), nb_grades },
+        { SNAPSHOT_SECTION_STRINGS, 0, 0, strings_size, strings_size },
+        { SNAPSHOT_SECTION_ID_INDEX, 0, 0, (uint64_t)p->num_students * sizeof(SnapshotIndexEntry), (uint64_t)p->num_students },
+        { SNAPSHOT_SECTION_JOURNAL, 0, 0, sizeof(uint64_t), 1 },
+        { SNAPSHOT_SECTION_BLOCK_CRCS, 0, 0, 0, 0 },
+    };
+    uint64_t nb_blocks = 0;
+    for (int k = 0; k < SNAPSHOT_NUM_SECTIONS - 1; k++)
+        nb_blocks += blockCount(sections[k].size);
+    sections[SNAPSHOT_NUM_SECTIONS - 1].size = nb_blocks * sizeof(uint32_t);
+    sections[SNAPSHOT_NUM_SECTIONS - 1].count = nb_blocks;
+    uint64_t offset = align8(sizeof(SnapshotHeader) + sizeof(sections));
+    for (int k = 0; k < SNAPSHOT_NUM_SECTIONS; k++) {
+        sections[k].offset = offset;
+        offset = align8(offset + sections[k].size);
+    }
+
+    // Le fichier entier est construit en mémoire (zéros pour le bourrage et les champs réservés)
+    unsigned char* buffer = calloc(offset, 1);
+    if (buffer == NULL) {
+        fprintf(stderr, "Erreur : allocation impossible pour le snapshot.\n");
+        return -1;
+    }
+
+    SnapshotHeader* header = (SnapshotHeader*)buffer;
+    memcpy(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic));
+    header->version = SNAPSHOT_VERSION;
+    header->num_sections = SNAPSHOT_NUM_SECTIONS;
+    header->file_size = offset;
+
+    SnapshotStudent* students = (SnapshotStudent*)(buffer + sections[0].offset);
+    SnapshotCourse* courses = (SnapshotCourse*)(buffer + sections[1].offset);
+    SnapshotEnrollment* enrollments = (SnapshotEnrollment*)(buffer + sections[2].offset);
+    uint8_t* grades = buffer + sections[3].offset;
+    char* strings = (char*)(buffer + sections[4].offset);
+    SnapshotIndexEntry* id_index = (SnapshotIndexEntry*)(buffer + sections[5].offset);
+    memcpy(buffer + sections[6].offset, &journal_generation, sizeof(uint64_t));
+
+    uint32_t next_string = 0, next_enrollment = 0, next_grade = 0;
+    for (int c = 0; c < p->num_courses; c++) {
+        const Course* course = &p->courses[c];
+        courses[c].name = next_string;
+        courses[c].name_length = (uint32_t)course->name_length;
+        courses[c].coeff = course->coeff;
+        memcpy(strings + next_string, course->course_name, course->name_length + 1);
+        next_string += course->name_length + 1;
+    }
+
+    for (int i = 0; i < p->num_students; i++) {
+        const Student* s = p->students[i];
+        SnapshotStudent* rec = &students[i];
+        rec->student_id = s->student_id;
+        rec->age = s->age;
+        rec->general_average = s->general_average;
+        id_index[i].student_id = s->student_id;
+        id_index[i].position = (uint32_t)i;
+
+        size_t len = strlen(s->first_name) + 1;
+        rec->first_name = next_string;
+        memcpy(strings + next_string, s->first_name, len);
+        next_string += (uint32_t)len;
+
+        len = strlen(s->last_name) + 1;
+        rec->last_name = next_string;
+        memcpy(strings + next_string, s->last_name, len);
+        next_string += (uint32_t)len;
+
+        rec->first_enrollment = next_enrollment;
+        rec->num_enrollments = (uint32_t)s->num_courses;
+        for (int j = 0; j < s->num_courses; j++) {
+            const Enrollment* e = &s->courses[j];
+            SnapshotEnrollment* er = &enrollments[next_enrollment++];
+            er->course_index = (uint32_t)e->course_index;
+            er->average = e->average;
+            er->first_grade = next_grade;
+            er->num_grades = (uint32_t)e->grades.size;
+            if (e->grades.size > 0)
+                memcpy(grades + next_grade, e->grades.grades_array, sizeof(uint8_t) * e->grades.size);
+            next_grade += (uint32_t)e->grades.size;
+        }
+    }
+
+    qsort(id_index, p->num_students, sizeof(SnapshotIndexEntry), compareIndexEntries);
+
+    // Sommes de contrôle, une fois toutes les sections remplies : par bloc, puis par section
+    uint32_t* block_crcs = (uint32_t*)(buffer + sections[SNAPSHOT_NUM_SECTIONS - 1].offset);
+    for (int k = 0; k < SNAPSHOT_NUM_SECTIONS - 1; k++) {
+        for (uint64_t b = 0; b < sections[k].size; b += SNAPSHOT_CRC_BLOCK) {
+            uint64_t length = sections[k].size - b < SNAPSHOT_CRC_BLOCK ? sections[k].size - b : SNAPSHOT_CRC_BLOCK;
+            *block_crcs++ = crc32c(0, buffer + sections[k].offset + b, length);
+        }
+    }
+    for (int k = 0; k < SNAPSHOT_NUM_SECTIONS; k++)
+        sections[k].crc = crc32c(0, buffer + sections[k].offset, sections[k].size);
+    memcpy(buffer + sizeof(SnapshotHeader), sections, sizeof(sections));
+    header->table_crc = crc32c(0, sections, sizeof(sections));
+
+    FILE* data = fopen(filename, "wb");
+    if (data == NULL) {
+        fprintf(stderr, "Erreur : impossible d’écrire dans le fichier %s.\n", filename);
+        free(buffer);
+        return -1;
+    }
+
+    int status = 0;
+    if (fwrite(buffer, 1, offset, data) != offset) {
+        fprintf(stderr, "Erreur lors de l’écriture du snapshot %s.\n", filename);
+        status = -1;
+    }
+    if (fclose(data) != 0)
+        status = -1;
+    free(buffer);
+    return status;
+}
+
+/**
+ * @brief Vérifie une entrée de la table des sections et renvoie le début de ses données.
+ * @return Le début de la section, ou NULL si elle déborde du fichier ou n’a pas la taille attendue.
+ */
+static const void* sectionData(const unsigned char* base, uint64_t file_size,
+                               const SnapshotSection* sec, size_t record_size) {
+    if (sec->offset % 8 != 0 || sec->offset > file_size || sec->size > file_size - sec->offset)
+        return NULL;
+    if (sec->count > UINT32_MAX || sec->size != sec->count * record_size)
+        return NULL;
+    return base + sec->offset;
+}
+
+/**
+ * @brief Ouvre un snapshot par projection mémoire.
+ */
+Snapshot* openSnapshot(const char* filename) {
+    if (filename == NULL)
+        return NULL;
+    if (!hostIsLittleEndian()) {
+        fprintf(stderr, "Erreur : format snapshot non pris en charge sur cette machine.\n");
+        return NULL;
+    }
+
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1)
+        return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) == -1 || (size_t)st.st_size < sizeof(SnapshotHeader)) {
+        close(fd);
+        return NULL;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return NULL;
+
+    Snapshot* snap = calloc(1, sizeof(Snapshot));
+    if (snap == NULL) {
+        munmap(map, size);
+        return NULL;
+    }
+    snap->map = map;
+    snap->size = size;
+
+    const unsigned char* base = map;
+    const SnapshotHeader* header = map;
+    int valid = memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) == 0 &&
+                header->version == SNAPSHOT_VERSION &&
+                header->file_size == size &&
+                header->num_sections <= SNAPSHOT_MAX_SECTIONS &&
+                sizeof(SnapshotHeader) + header->num_sections * sizeof(SnapshotSection) <= size;
+
+    int found = 0;
+    uint64_t nb_blocks = 0, nb_block_crcs = 0;
+    const SnapshotSection* table = (const SnapshotSection*)(base + sizeof(SnapshotHeader));
+    valid = valid && crc32c(0, table, header->num_sections * sizeof(SnapshotSection)) == header->table_crc;
+    for (uint32_t k = 0; valid && k < header->num_sections; k++) {
+        const SnapshotSection* sec = &table[k];
+        switch (sec->id) {
+            case SNAPSHOT_SECTION_STUDENTS:
+                snap->students = sectionData(base, size, sec, sizeof(SnapshotStudent));
+                snap->num_students = (int)sec->count;
+                valid = snap->students != NULL && sec->count <= INT32_MAX;
+                break;
+            case SNAPSHOT_SECTION_COURSES:
+                snap->courses = sectionData(base, size, sec, sizeof(SnapshotCourse));
+                snap->num_courses = (int)sec->count;
+                valid = snap->courses != NULL && sec->count <= INT32_MAX;
+                break;
+            case SNAPSHOT_SECTION_ENROLLMENTS:
+                snap->enrollments = sectionData(base, size, sec, sizeof(SnapshotEnrollment));
+                snap->num_enrollments = (uint32_t)sec->count;
+                valid = snap->enrollments != NULL;
+                break;
+            case SNAPSHOT_SECTION_GRADES:
+                snap->grades = sectionData(base, size, sec, sizeof(uint8_t));
+                snap->num_grades = (uint32_t)sec->count;
+                valid = snap->grades != NULL;
+                break;
+            case SNAPSHOT_SECTION_STRINGS:
+                snap->strings = sectionData(base, size, sec, 1);
+                snap->strings_size = (uint32_t)sec->count;
+                // Une table terminée par '\0' garantit que toute chaîne lue y reste contenue
+                valid = snap->strings != NULL &&
+                        (sec->count == 0 || snap->strings[sec->count - 1] == '\0');
+                break;
+            case SNAPSHOT_SECTION_ID_INDEX:
+                snap->id_index = sectionData(base, size, sec, sizeof(SnapshotIndexEntry));
+                snap->num_index = (int)sec->count;
+                valid = snap->id_index != NULL && sec->count <= INT32_MAX;
+                break;
+            case SNAPSHOT_SECTION_JOURNAL: {
+                const void* data = sectionData(base, size, sec, sizeof(uint64_t));
+                valid = data != NULL && sec->count == 1;
+                if (valid)
+                    memcpy(&snap->journal_generation, data, sizeof(uint64_t));
+                break;
+            }
+            case SNAPSHOT_SECTION_BLOCK_CRCS:
+                snap->block_crcs = sectionData(base, size, sec, sizeof(uint32_t));
+                nb_block_crcs = sec->count;
+                valid = snap->block_crcs != NULL;
+                break;
+            default:
+                continue;   // section inconnue : ignorée
+        }
+        found |= 1 << sec->id;
+        if (hasBlockCrcs(sec->id))
+            nb_blocks += blockCount(sec->size);
+    }
+
+    // Une somme par bloc des sections couvertes, ni plus ni moins
+    valid = valid && (snap->block_crcs == NULL || nb_block_crcs == nb_blocks);
+
+    int required = (1 << SNAPSHOT_SECTION_STUDENTS) | (1 << SNAPSHOT_SECTION_COURSES) |
+                   (1 << SNAPSHOT_SECTION_ENROLLMENTS) | (1 << SNAPSHOT_SECTION_GRADES) |
+                   (1 << SNAPSHOT_SECTION_STRINGS);
+    if (!valid || (found & required) != required) {
+        fprintf(stderr, "Erreur : snapshot %s invalide.\n", filename);
+        closeSnapshot(snap);
+        return NULL;
+    }
+    return snap;
+}
+
+/**
+ * @brief Vérifie la somme de contrôle des sections dont l’identifiant est dans `mask` (bit `1 << id`).
+ *
+ * La table a été validée par `openSnapshot()` : chaque section est dans le fichier.
+ *
+ * @return 0 si ces sections sont intactes, -1 sinon.
+ */
+static int verifySnapshotSections(const Snapshot* snap, uint32_t mask) {
+    if (snap == NULL)
+        return -1;
+
+    const unsigned char* base = snap->map;
+    const SnapshotHeader* header = snap->map;
+    const SnapshotSection* table = (const SnapshotSection*)(base + sizeof(SnapshotHeader));
+    for (uint32_t k = 0; k < header->num_sections; k++) {
+        const SnapshotSection* sec = &table[k];
+        if (sec->id >= 32 || !(mask & (1u << sec->id)))
+            continue;
+        if (sec->offset > snap->size || sec->size > snap->size - sec->offset ||
+            crc32c(0, base + sec->offset, sec->size) != sec->crc) {
+            fprintf(stderr, "Erreur : section %u du snapshot corrompue.\n", sec->id);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Vérifie les blocs d’une section qui recouvrent une plage d’octets.
+ *
+ * Sans sommes par bloc, toute la section est vérifiée. La somme d’un bloc n’est pas
+ * elle-même contrôlée : altérée, elle ne peut que faire refuser un bloc intact.
+ *
+ * @param offset Début de la plage, depuis le début de la section.
+ * @param length Longueur de la plage (0 : rien à vérifier).
+ * @return 0 si ces blocs sont intacts, -1 sinon.
+ */
+static int verifySnapshotRange(const Snapshot* snap, uint32_t id, uint64_t offset, uint64_t length) {
+    if (snap->block_crcs == NULL)
+        return verifySnapshotSections(snap, 1u << id);
+    if (length == 0)
+        return 0;
+
+    // Premier bloc de la section : blocs des sections couvertes qui la précèdent dans la table
+    const unsigned char* base = snap->map;
+    const SnapshotHeader* header = snap->map;
+    const SnapshotSection* table = (const SnapshotSection*)(base + sizeof(SnapshotHeader));
+    uint64_t first_block = 0;
+    for (uint32_t k = 0; k < header->num_sections; k++) {
+        const SnapshotSection* sec = &table[k];
+        if (!hasBlockCrcs(sec->id))
+            continue;
+        if (sec->id != id) {
+            first_block += blockCount(sec->size);
+            continue;
+        }
+        if (offset > sec->size || length > sec->size - offset)
+            return -1;
+
+        for (uint64_t b = offset / SNAPSHOT_CRC_BLOCK; b * SNAPSHOT_CRC_BLOCK < offset + length; b++) {
+            uint64_t start = b * SNAPSHOT_CRC_BLOCK;
+            uint64_t size = sec->size - start < SNAPSHOT_CRC_BLOCK ? sec->size - start : SNAPSHOT_CRC_BLOCK;
+            if (crc32c(0, base + sec->offset + start, size) != snap->block_crcs[first_block + b]) {
+                fprintf(stderr, "Erreur : bloc %llu de la section %u du snapshot corrompu.\n",
+                        (unsigned long long)b, id);
+                return -1;
+            }
+        }
+        return 0;
+    }
+    return -1;
+}
+
+/**
+ * @brief Vérifie la somme de contrôle de chaque section d’un snapshot ouvert.
+ */
+int verifySnapshot(const Snapshot* snap) {
+    return verifySnapshotSections(snap, UINT32_MAX);
+}
+
+/**
+ * @brief Ferme un snapshot et libère sa projection.
+ */
+void closeSnapshot(Snapshot* snap) {
+    if (snap == NULL)
+        return;
+    munmap(snap->map, snap->size);
+    free(snap);
+}
+
+/**
+ * @brief Retourne une chaîne de la table des chaînes.
+ */
+const char* getSnapshotString(const Snapshot* snap, uint32_t offset) {
+    if (snap == NULL || offset >= snap->strings_size)
+        return NULL;
+    return snap->strings + offset;
+}
+
+/**
+ * @brief Retourne les inscriptions d’un étudiant du snapshot.
+ */
+const SnapshotEnrollment* getSnapshotEnrollments(const Snapshot* snap, const SnapshotStudent* student, int* count) {
+    *count = 0;
+    if (snap == NULL || student == NULL ||
+        student->first_enrollment > snap->num_enrollments ||
+        student->num_enrollments > snap->num_enrollments - student->first_enrollment)
+        return NULL;
+
+    *count = (int)student->num_enrollments;
+    return snap->enrollments + student->first_enrollment;
+}
+
+/**
+ * @brief Retourne les notes d’une inscription du snapshot.
+ */
+const uint8_t* getSnapshotGrades(const Snapshot* snap, const SnapshotEnrollment* enrollment, int* count) {
+    *count = 0;
+    if (snap == NULL || enrollment == NULL ||
+        enrollment->first_grade > snap->num_grades ||
+        enrollment->num_grades > snap->num_grades - enrollment->first_grade)
+        return NULL;
+
+    *count = (int)enrollment->num_grades;
+    return snap->grades + enrollment->first_grade;
+}
+
+/**
+ * @brief Recherche un cours du snapshot par son nom.
+ */
+int findSnapshotCourse(const Snapshot* snap, const char* name) {
+    if (snap == NULL || name == NULL)
+        return -1;
+
+    size_t length = strlen(name);
+    for (int c = 0; c < snap->num_courses; c++) {
+        const char* course_name = getSnapshotString(snap, snap->courses[c].name);
+        if (course_name != NULL && snap->courses[c].name_length == length &&
+            memcmp(course_name, name, length) == 0)
+            return c;
+    }
+    return -1;
+}
+
+/**
+ * @brief Recherche dans l’index la première entrée d’un numéro.
+ * @return La position de l’entrée dans l’index, ou -1 si le numéro en est absent.
+ */
+static int findIndexEntry(const Snapshot* snap, int student_id) {
+    // Première entrée dont le numéro est >= student_id
+    int lo = 0, hi = snap->num_index;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (snap->id_index[mid].student_id < student_id)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo == snap->num_index || snap->id_index[lo].student_id != student_id)
+        return -1;
+    return lo;
+}
+
+/**
+ * @brief Recherche un étudiant du snapshot par son numéro.
+ */
+const SnapshotStudent* findSnapshotStudent(const Snapshot* snap, int student_id) {
+    if (snap == NULL)
+        return NULL;
+
+    if (snap->id_index == NULL) {
+        for (int i = 0; i < snap->num_students; i++)
+            if (snap->students[i].student_id == student_id)
+                return &snap->students[i];
+        return NULL;
+    }
+
+    int entry = findIndexEntry(snap, student_id);
+    if (entry == -1)
+        return NULL;
+    uint32_t position = snap->id_index[entry].position;
+    if (position >= (uint32_t)snap->num_students || snap->students[position].student_id != student_id)
+        return NULL;
+    return &snap->students[position];
+}
+
+/**
+ * @brief Crée une promotion vide avec le catalogue du snapshot, dans le même ordre.
+ * @return La promotion, ou NULL si le catalogue est invalide.
+ */
+static Prom* createPromFromSnapshotCatalog(const Snapshot* snap, int capacity, int flags) {
+    Prom* promo = (flags & LOAD_ARENA) ? createArenaProm(capacity) : createProm(capacity, 0);
+    if (promo == NULL) {
+        fprintf(stderr, "Erreur : allocation impossible pour la promotion.\n");
+        return NULL;
+    }
+
+    // Un catalogue sauvegardé ne contient pas de doublon : l’indice du cours c reste c
+    for (int c = 0; c < snap->num_courses; c++) {
+        const SnapshotCourse* rec = &snap->courses[c];
+        const char* name = getSnapshotString(snap, rec->name);
+        if (name == NULL || rec->name_length > snap->strings_size - rec->name ||
+            addCourseToPromN(promo, name, rec->name_length, rec->coeff) != c) {
+            fprintf(stderr, "Erreur : cours %d du snapshot invalide.\n", c);
+            destroyProm(promo);
+            return NULL;
+        }
+    }
+    return promo;
+}
+
+/**
+ * @brief Matérialise un étudiant du snapshot et l’ajoute à la promotion.
+ * @return 0 si succès, -1 si l’enregistrement est invalide ou en cas d’erreur d’allocation.
+ */
+static int restoreSnapshotStudent(const Snapshot* snap, const SnapshotStudent* rec, Prom* promo) {
+    const char* first_name = getSnapshotString(snap, rec->first_name);
+    const char* last_name = getSnapshotString(snap, rec->last_name);
+    int nb_enrollments;
+    const SnapshotEnrollment* enrollments = getSnapshotEnrollments(snap, rec, &nb_enrollments);
+    if (first_name == NULL || last_name == NULL || enrollments == NULL) {
+        fprintf(stderr, "Erreur : étudiant %d du snapshot invalide.\n", rec->student_id);
+        return -1;
+    }
+
+    Student* s = createStudentN(promo->arena, rec->student_id, first_name, strlen(first_name),
+                                last_name, strlen(last_name), rec->age);
+    if (s == NULL || addStudentToProm(promo, s) == -1) {
+        fprintf(stderr, "Erreur : allocation impossible pour l’étudiant %d.\n", rec->student_id);
+        if (s != NULL && promo->arena == NULL)
+            destroyStudent(s);
+        return -1;
+    }
+    s->general_average = rec->general_average;
+
+    // À partir d’ici, l’étudiant appartient à la promotion : destroyProm() suffit en cas d’erreur
+    int status = reserveEnrollments(promo->arena, s, nb_enrollments);
+    for (int j = 0; j < nb_enrollments && status == 0; j++) {
+        const SnapshotEnrollment* er = &enrollments[j];
+        int nb_grades;
+        const uint8_t* grades = getSnapshotGrades(snap, er, &nb_grades);
+        if (grades == NULL || er->course_index >= (uint32_t)promo->num_courses) {
+            status = -1;
+            break;
+        }
+
+        Enrollment* e = addEnrollmentToProm(promo, s, (int)er->course_index);
+        if (e == NULL || reserveGrades(promo->arena, &e->grades, nb_grades) == -1) {
+            status = -1;
+            break;
+        }
+        for (int n = 0; n < nb_grades && status == 0; n++) {
+            if (grades[n] > GRADE_MAX_TENTHS)
+                status = -1;
+            e->grades.grades_array[n] = grades[n];
+        }
+        e->grades.size = nb_grades;
+        e->average = er->average;
+    }
+    if (status == -1) {
+        fprintf(stderr, "Erreur : inscriptions de l’étudiant %d invalides.\n", rec->student_id);
+        return -1;
+    }
+
+    refreshStudentTotals(promo, s);
+    return 0;
+}
+
+/**
+ * @brief Reconstruit une promotion ne contenant qu’un étudiant du snapshot.
+ */
+Prom* loadStudentFromSnapshot(const Snapshot* snap, int student_id) {
+    const SnapshotStudent* rec = findSnapshotStudent(snap, student_id);
+    if (rec == NULL)
+        return NULL;
+
+    Prom* promo = createPromFromSnapshotCatalog(snap, 1, LOAD_DEFAULT);
+    if (promo == NULL)
+        return NULL;
+    if (restoreSnapshotStudent(snap, rec, promo) == -1) {
+        destroyProm(promo);
+        return NULL;
+    }
+    return promo;
+}
+
+/**
+ * @brief Vérifie les blocs lus pour matérialiser un étudiant du snapshot.
+ *
+ * Les positions sont bornées avant d’être vérifiées : un enregistrement altéré est
+ * refusé ici ou par les fonctions d’accès, sans lecture hors de la projection.
+ *
+ * @return 0 si ces blocs sont intacts, -1 sinon.
+ */
+static int verifyStudentBlocks(const Snapshot* snap, const SnapshotStudent* rec) {
+    uint64_t position = (uint64_t)(rec - snap->students);
+    if (verifySnapshotRange(snap, SNAPSHOT_SECTION_STUDENTS, position * sizeof(SnapshotStudent),
+                            sizeof(SnapshotStudent)) == -1)
+        return -1;
+
+    if (snap->id_index != NULL) {
+        int entry = findIndexEntry(snap, rec->student_id);
+        if (entry == -1 || verifySnapshotRange(snap, SNAPSHOT_SECTION_ID_INDEX,
+                                               (uint64_t)entry * sizeof(SnapshotIndexEntry),
+                                               sizeof(SnapshotIndexEntry)) == -1)
+            return -1;
+    }
+
+    // Catalogue complet (petit), et noms des cours : une seule plage de chaînes
+    uint64_t lo = UINT64_MAX, hi = 0;
+    for (int c = 0; c < snap->num_courses; c++) {
+        const SnapshotCourse* course = &snap->courses[c];
+        if (course->name >= snap->strings_size || course->name_length >= snap->strings_size - course->name)
+            return -1;
+        lo = course->name < lo ? course->name : lo;
+        hi = course->name + course->name_length + 1 > hi ? course->name + course->name_length + 1 : hi;
+    }
+    if (verifySnapshotRange(snap, SNAPSHOT_SECTION_COURSES, 0, (uint64_t)snap->num_courses * sizeof(SnapshotCourse)) == -1 ||
+        (hi > lo && verifySnapshotRange(snap, SNAPSHOT_SECTION_STRINGS, lo, hi - lo) == -1))
+        return -1;
+
+    // Prénom et nom
+    const char* first_name = getSnapshotString(snap, rec->first_name);
+    const char* last_name = getSnapshotString(snap, rec->last_name);
+    if (first_name == NULL || last_name == NULL ||
+        verifySnapshotRange(snap, SNAPSHOT_SECTION_STRINGS, rec->first_name, strlen(first_name) + 1) == -1 ||
+        verifySnapshotRange(snap, SNAPSHOT_SECTION_STRINGS, rec->last_name, strlen(last_name) + 1) == -1)
+        return -1;
+
+    // Inscriptions, puis la plage qui contient toutes leurs notes
+    int nb_enrollments;
+    const SnapshotEnrollment* enrollments = getSnapshotEnrollments(snap, rec, &nb_enrollments);
+    if (enrollments == NULL ||
+        verifySnapshotRange(snap, SNAPSHOT_SECTION_ENROLLMENTS,
+                            (uint64_t)rec->first_enrollment * sizeof(SnapshotEnrollment),
+                            (uint64_t)nb_enrollments * sizeof(SnapshotEnrollment)) == -1)
+        return -1;
+
+    lo = UINT64_MAX;
+    hi = 0;
+    for (int j = 0; j < nb_enrollments; j++) {
+        int nb_grades;
+        if (getSnapshotGrades(snap, &enrollments[j], &nb_grades) == NULL)
+            return -1;
+        if (nb_grades == 0)
+            continue;
+        lo = enrollments[j].first_grade < lo ? enrollments[j].first_grade : lo;
+        hi = (uint64_t)enrollments[j].first_grade + nb_grades > hi ? (uint64_t)enrollments[j].first_grade + nb_grades : hi;
+    }
+    return (hi > lo) ? verifySnapshotRange(snap, SNAPSHOT_SECTION_GRADES, lo, hi - lo) : 0;
+}
+
+/**
+ * @brief Lit un seul étudiant d’un fichier snapshot, sans restaurer la promotion.
+ */
+Prom* loadStudentFromBinaryFile(const char* filename, int student_id) {
+    Snapshot* snap = openSnapshot(filename);
+    if (snap == NULL)
+        return NULL;
+
+    Prom* promo = NULL;
+    const SnapshotStudent* rec = findSnapshotStudent(snap, student_id);
+    if (rec != NULL && verifyStudentBlocks(snap, rec) == 0)
+        promo = loadStudentFromSnapshot(snap, student_id);
+    closeSnapshot(snap);
+    return promo;
+}
+
+/**
+ * @brief Reconstruit une promotion complète à partir d’un snapshot ouvert.
+ */
+Prom* loadPromotionFromSnapshot(const Snapshot* snap, int flags) {
+    if (snap == NULL || verifySnapshot(snap) == -1)
+        return NULL;
+
+    Prom* promo = createPromFromSnapshotCatalog(snap, snap->num_students, flags);
+    if (promo == NULL)
+        return NULL;
+
+    for (int i = 0; i < snap->num_students; i++) {
+        if (restoreSnapshotStudent(snap, &snap->students[i], promo) == -1) {
+            destroyProm(promo);
+            return NULL;
+        }
+    }
+    return promo;
+}
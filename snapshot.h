@@ -0,0 +1,320 @@
+/**
+ * @file snapshot.h
+ * @brief Format binaire en sections d’une promotion (« snapshot »), utilisable directement par projection mémoire.
+ *
+ * Contrairement au format v1 de `saveInBinaryFile()`, qui doit être relu champ par
+ * champ, un snapshot est un ensemble de sections à plat :
+ * - un en-tête (nombre magique, version, taille du fichier) suivi d’une table des sections ;
+ * - les étudiants, en enregistrements de taille fixe alignés ;
+ * - le catalogue des cours ;
+ * - les inscriptions, chacune désignant un cours du catalogue et une plage de notes ;
+ * - toutes les notes, dans un seul tableau d’octets (dixièmes de point, comme en mémoire) ;
+ * - une table de chaînes (prénoms, noms et noms de cours terminés par `'\0'`) ;
+ * - un index trié des numéros d’étudiants, pour retrouver un étudiant par recherche dichotomique ;
+ * - les sommes de contrôle des autres sections, bloc de `SNAPSHOT_CRC_BLOCK` octets par bloc.
+ *
+ * Tous les entiers et flottants sont en little-endian et chaque section commence
+ * sur une frontière de 8 octets. `openSnapshot()` projette le fichier en mémoire et
+ * ne vérifie que l’en-tête et la table des sections : l’ouverture ne dépend pas de la
+ * taille de la promotion, et les données sont lues en place, sans copie.
+ *
+ * La table des sections et chaque section portent une somme de contrôle CRC32C
+ * (voir crc32c.h). `verifySnapshot()` contrôle toutes les sections à la vitesse de
+ * la mémoire ; `loadPromotionFromSnapshot()` l’appelle avant de restaurer quoi que ce
+ * soit. `loadStudentFromBinaryFile()`, elle, ne vérifie que les blocs qu’elle lit
+ * (entrée d’index, étudiant, inscriptions, notes, chaînes et catalogue), grâce aux
+ * sommes par bloc : quelques pages, quelle que soit la taille du fichier.
+ *
+ * @note Les enregistrements sont lus tels quels : la lecture en place suppose une
+ * machine little-endian (les autres refusent d’écrire ou d’ouvrir un snapshot).
+ *
+ * @see file_gestion.h
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "./struct.h"
+
+/** @brief Nombre magique au début de chaque snapshot. */
+#define SNAPSHOT_MAGIC "PROMSNAP"
+
+/**
+ * @brief Version du format.
+ *
+ * La version 1 est le format historique de `saveInBinaryFile()` ; la version 2 stockait
+ * les notes en `float` et la version 3 n’avait pas de sommes de contrôle. Elles ne
+ * sont plus acceptées.
+ */
+#define SNAPSHOT_VERSION 4
+
+/** @brief Identifiant de la section des étudiants (`SnapshotStudent`). */
+#define SNAPSHOT_SECTION_STUDENTS 1
+/** @brief Identifiant de la section du catalogue (`SnapshotCourse`). */
+#define SNAPSHOT_SECTION_COURSES 2
+/** @brief Identifiant de la section des inscriptions (`SnapshotEnrollment`). */
+#define SNAPSHOT_SECTION_ENROLLMENTS 3
+/** @brief Identifiant de la section des notes (`uint8_t`, en dixièmes de point). */
+#define SNAPSHOT_SECTION_GRADES 4
+/** @brief Identifiant de la table des chaînes. */
+#define SNAPSHOT_SECTION_STRINGS 5
+/** @brief Identifiant de l’index des numéros d’étudiants (`SnapshotIndexEntry`, triés), facultatif. */
+#define SNAPSHOT_SECTION_ID_INDEX 6
+/** @brief Identifiant de la section donnant la génération du journal à rejouer (un `uint64_t`), facultatif. */
+#define SNAPSHOT_SECTION_JOURNAL 7
+/**
+ * @brief Identifiant de la section des sommes de contrôle par bloc (`uint32_t`), facultative.
+ *
+ * Pour chaque section d’identifiant `SNAPSHOT_SECTION_STUDENTS` à `SNAPSHOT_SECTION_JOURNAL`,
+ * dans l’ordre de la table, le CRC32C de chacun de ses blocs de `SNAPSHOT_CRC_BLOCK`
+ * octets (le dernier pouvant être plus court), comptés depuis le début de la section.
+ */
+#define SNAPSHOT_SECTION_BLOCK_CRCS 8
+
+/** @brief Taille des blocs couverts par une somme de la section `SNAPSHOT_SECTION_BLOCK_CRCS`. */
+#define SNAPSHOT_CRC_BLOCK 4096
+
+/**
+ * @struct SnapshotHeader
+ * @brief En-tête d’un snapshot (32 octets), suivi de `num_sections` entrées `SnapshotSection`.
+ */
+typedef struct SnapshotHeader {
+    char magic[8];            /**< `SNAPSHOT_MAGIC`, sans `'\0'`. */
+    uint32_t version;         /**< `SNAPSHOT_VERSION`. */
+    uint32_t num_sections;    /**< Nombre d’entrées de la table des sections. */
+    uint64_t file_size;       /**< Taille totale attendue du fichier. */
+    uint32_t table_crc;       /**< CRC32C de la table des sections. */
+    uint32_t reserved;        /**< Réservé, à 0. */
+} SnapshotHeader;
+
+/**
+ * @struct SnapshotSection
+ * @brief Entrée de la table des sections.
+ */
+typedef struct SnapshotSection {
+    uint32_t id;              /**< Identifiant `SNAPSHOT_SECTION_*`. */
+    uint32_t crc;             /**< CRC32C des `size` octets de la section. */
+    uint64_t offset;          /**< Position de la section depuis le début du fichier (multiple de 8). */
+    uint64_t size;            /**< Taille de la section en octets. */
+    uint64_t count;           /**< Nombre d’éléments de la section. */
+} SnapshotSection;
+
+/**
+ * @struct SnapshotStudent
+ * @brief Enregistrement d’un étudiant (32 octets).
+ */
+typedef struct SnapshotStudent {
+    int32_t student_id;         /**< Numéro de l’étudiant. */
+    int32_t age;                /**< Âge. */
+    float general_average;      /**< Moyenne générale. */
+    uint32_t first_name;        /**< Position du prénom dans la table des chaînes. */
+    uint32_t last_name;         /**< Position du nom dans la table des chaînes. */
+    uint32_t first_enrollment;  /**< Indice de la première inscription de l’étudiant. */
+    uint32_t num_enrollments;   /**< Nombre d’inscriptions (consécutives). */
+    uint32_t reserved;          /**< Réservé, à 0. */
+} SnapshotStudent;
+
+/**
+ * @struct SnapshotCourse
+ * @brief Enregistrement d’un cours du catalogue (16 octets).
+ */
+typedef struct SnapshotCourse {
+    uint32_t name;              /**< Position du nom dans la table des chaînes. */
+    uint32_t name_length;       /**< Longueur du nom, sans `'\0'`. */
+    float coeff;                /**< Coefficient. */
+    uint32_t reserved;          /**< Réservé, à 0. */
+} SnapshotCourse;
+
+/**
+ * @struct SnapshotEnrollment
+ * @brief Enregistrement d’une inscription (16 octets).
+ */
+typedef struct SnapshotEnrollment {
+    uint32_t course_index;      /**< Indice du cours dans la section du catalogue. */
+    float average;              /**< Moyenne de l’étudiant dans le cours. */
+    uint32_t first_grade;       /**< Indice de la première note dans la section des notes. */
+    uint32_t num_grades;        /**< Nombre de notes (consécutives). */
+} SnapshotEnrollment;
+
+/**
+ * @struct SnapshotIndexEntry
+ * @brief Entrée de l’index des numéros (8 octets), triée par numéro puis par position.
+ */
+typedef struct SnapshotIndexEntry {
+    int32_t student_id;         /**< Numéro de l’étudiant. */
+    uint32_t position;          /**< Indice de l’enregistrement dans la section des étudiants. */
+} SnapshotIndexEntry;
+
+/**
+ * @struct Snapshot
+ * @brief Snapshot ouvert : pointeurs vers les sections de la projection mémoire.
+ */
+typedef struct Snapshot {
+    void* map;                              /**< Début de la projection. */
+    size_t size;                            /**< Taille de la projection. */
+    const SnapshotStudent* students;        /**< Section des étudiants. */
+    int num_students;                       /**< Nombre d’étudiants. */
+    const SnapshotCourse* courses;          /**< Section du catalogue. */
+    int num_courses;                        /**< Nombre de cours. */
+    const SnapshotEnrollment* enrollments;  /**< Section des inscriptions. */
+    uint32_t num_enrollments;               /**< Nombre d’inscriptions. */
+    const uint8_t* grades;                  /**< Section des notes, en dixièmes de point. */
+    uint32_t num_grades;                    /**< Nombre de notes. */
+    const char* strings;                    /**< Table des chaînes. */
+    uint32_t strings_size;                  /**< Taille de la table des chaînes. */
+    const SnapshotIndexEntry* id_index;     /**< Index des numéros, NULL s’il est absent du fichier. */
+    int num_index;                          /**< Nombre d’entrées de l’index. */
+    uint64_t journal_generation;            /**< Génération du journal associé (0 si la section est absente). */
+    const uint32_t* block_crcs;             /**< Sommes de contrôle par bloc, NULL si la section est absente. */
+} Snapshot;
+
+/**
+ * @brief Écrit une promotion au format snapshot.
+ *
+ * Le fichier est construit entièrement en mémoire puis écrit en un seul appel.
+ *
+ * @param filename Nom du fichier de destination.
+ * @param p        Promotion à sauvegarder.
+ * @return 0 si succès, -1 en cas d’erreur.
+ */
+int saveSnapshot(const char* filename, const Prom* p);
+
+/**
+ * @brief Écrit une promotion au format snapshot en indiquant la génération du journal associé.
+ *
+ * Seules les entrées d’un journal de cette génération seront rejouées sur le snapshot
+ * (voir journal.h). `saveSnapshot()` utilise la génération 0.
+ *
+ * @param filename           Nom du fichier de destination.
+ * @param p                  Promotion à sauvegarder.
+ * @param journal_generation Génération du journal associé.
+ * @return 0 si succès, -1 en cas d’erreur.
+ */
+int saveSnapshotWithGeneration(const char* filename, const Prom* p, uint64_t journal_generation);
+
+/**
+ * @brief Ouvre un snapshot par projection mémoire.
+ *
+ * Seuls l’en-tête et la table des sections sont vérifiés ; les positions lues dans
+ * les enregistrements sont contrôlées par les fonctions d’accès ci-dessous.
+ *
+ * @param filename Nom du snapshot.
+ * @return Le snapshot ouvert, ou NULL si le fichier est absent ou invalide.
+ *
+ * @note Le snapshot doit être fermé avec `closeSnapshot()`.
+ */
+Snapshot* openSnapshot(const char* filename);
+
+/**
+ * @brief Vérifie la somme de contrôle de chaque section d’un snapshot ouvert.
+ *
+ * Lit tout le fichier une fois ; à appeler avant de faire confiance à un snapshot
+ * dont on lit plus que quelques enregistrements.
+ *
+ * @param snap Snapshot ouvert.
+ * @return 0 si toutes les sections sont intactes, -1 sinon.
+ */
+int verifySnapshot(const Snapshot* snap);
+
+/**
+ * @brief Ferme un snapshot et libère sa projection.
+ *
+ * @param snap Snapshot à fermer (NULL accepté).
+ */
+void closeSnapshot(Snapshot* snap);
+
+/**
+ * @brief Retourne une chaîne de la table des chaînes.
+ *
+ * @param snap   Snapshot ouvert.
+ * @param offset Position de la chaîne.
+ * @return La chaîne (dans la projection), ou NULL si la position est invalide.
+ */
+const char* getSnapshotString(const Snapshot* snap, uint32_t offset);
+
+/**
+ * @brief Retourne les inscriptions d’un étudiant du snapshot.
+ *
+ * @param snap    Snapshot ouvert.
+ * @param student Étudiant du snapshot.
+ * @param count   Nombre d’inscriptions retournées.
+ * @return Les inscriptions (dans la projection), ou NULL si l’enregistrement est invalide.
+ */
+const SnapshotEnrollment* getSnapshotEnrollments(const Snapshot* snap, const SnapshotStudent* student, int* count);
+
+/**
+ * @brief Retourne les notes d’une inscription du snapshot.
+ *
+ * @param snap       Snapshot ouvert.
+ * @param enrollment Inscription du snapshot.
+ * @param count      Nombre de notes retournées.
+ * @return Les notes en dixièmes de point (dans la projection), ou NULL si l’enregistrement est invalide.
+ */
+const uint8_t* getSnapshotGrades(const Snapshot* snap, const SnapshotEnrollment* enrollment, int* count);
+
+/**
+ * @brief Recherche un cours du snapshot par son nom.
+ *
+ * @param snap Snapshot ouvert.
+ * @param name Nom du cours.
+ * @return L’indice du cours, ou -1 s’il est absent.
+ */
+int findSnapshotCourse(const Snapshot* snap, const char* name);
+
+/**
+ * @brief Recherche un étudiant du snapshot par son numéro.
+ *
+ * Utilise l’index trié (recherche dichotomique, quelques pages lues) ; un snapshot
+ * sans index est parcouru séquentiellement. En cas de doublon, le premier étudiant
+ * enregistré est retourné, comme `findStudentById()`.
+ *
+ * @param snap       Snapshot ouvert.
+ * @param student_id Numéro recherché.
+ * @return L’enregistrement (dans la projection), ou NULL s’il est absent.
+ */
+const SnapshotStudent* findSnapshotStudent(const Snapshot* snap, int student_id);
+
+/**
+ * @brief Reconstruit une promotion ne contenant qu’un étudiant du snapshot.
+ *
+ * La promotion retournée contient le catalogue complet (petit) et le seul étudiant
+ * demandé, avec ses inscriptions et ses notes. Les sommes de contrôle ne sont pas
+ * vérifiées ici : pour des recherches répétées sur un même snapshot, appeler
+ * `verifySnapshot()` une fois après `openSnapshot()`.
+ *
+ * @param snap       Snapshot ouvert.
+ * @param student_id Numéro de l’étudiant.
+ * @return La promotion allouée dynamiquement, ou NULL si l’étudiant est absent ou invalide.
+ */
+Prom* loadStudentFromSnapshot(const Snapshot* snap, int student_id);
+
+/**
+ * @brief Lit un seul étudiant d’un fichier snapshot, sans restaurer la promotion.
+ *
+ * Ouvre le snapshot, recherche l’étudiant dans l’index puis ne matérialise que lui
+ * (voir `loadStudentFromSnapshot()`). Seuls les blocs lus sont vérifiés : entrée
+ * d’index, enregistrement de l’étudiant, ses inscriptions, ses notes et ses chaînes,
+ * ainsi que le catalogue. Une corruption de ces blocs fait refuser la lecture ; un
+ * snapshot sans sommes par bloc est vérifié section par section.
+ *
+ * @param filename   Nom du snapshot.
+ * @param student_id Numéro de l’étudiant.
+ * @return La promotion d’un étudiant allouée dynamiquement, ou NULL en cas d’erreur.
+ */
+Prom* loadStudentFromBinaryFile(const char* filename, int student_id);
+
+/**
+ * @brief Reconstruit une promotion complète à partir d’un snapshot ouvert.
+ *
+ * Les sommes de contrôle sont vérifiées d’abord (voir `verifySnapshot()`) : un
+ * snapshot corrompu est refusé avant toute allocation.
+ *
+ * @param snap  Snapshot ouvert.
+ * @param flags Options de chargement (`LOAD_ARENA` est pris en compte).
+ * @return La promotion allouée dynamiquement, ou NULL en cas d’erreur.
+ */
+Prom* loadPromotionFromSnapshot(const Snapshot* snap, int flags);
+
+#endif // SNAPSHOT_H
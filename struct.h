@@ -4,8 +4,10 @@
  *
  * Ce fichier contient la définition des structures nécessaires à la représentation :
  * - des notes d’un cours (`Grades`),
- * - des cours suivis par un étudiant (`Course`),
+ * - des matières du catalogue (`Course`),
+ * - des inscriptions d’un étudiant à ces matières (`Enrollment`),
  * - des étudiants (`Student`),
+ * - des listes d’inscrits de chaque matière (`CourseRoster`),
  * - et d’une promotion entière (`Prom`).
  *
  * Ces structures servent de base à toutes les fonctions de manipulation des données
@@ -19,40 +21,97 @@
 #ifndef STRUCT_H
 #define STRUCT_H
 
+#include <stdint.h>
+#include "./arena.h"
+
+/** @brief Note maximale en dixièmes de point (20,0). */
+#define GRADE_MAX_TENTHS 200
+
 /**
  * @struct Grades
  * @brief Représente les notes d’un cours.
+ *
+ * Les notes sont stockées en dixièmes de point sur un octet (0 à `GRADE_MAX_TENTHS`) :
+ * la somme est entière, donc exacte, et la moyenne ne dépend pas de l’ordre des ajouts.
+ *
+ * Dans une promotion chargée avec `LOAD_AGGREGATE_ONLY`, seuls l’effectif, la somme
+ * et les extrêmes sont tenus : `grades_array` reste NULL et `capacity` à 0.
  */
 typedef struct Grades {
-    float* grades_array;  /**< Tableau dynamique contenant les notes. */
+    uint8_t* grades_array; /**< Tableau dynamique des notes, en dixièmes de point. */
     int size;             /**< Nombre de notes stockées dans le tableau. */
+    int capacity;         /**< Nombre de notes allouées (croissance géométrique). */
+    int sum;              /**< Somme courante des notes en dixièmes (mise à jour à chaque ajout). */
+    uint8_t min;          /**< Plus petite note en dixièmes (valable si `size` > 0). */
+    uint8_t max;          /**< Plus grande note en dixièmes (valable si `size` > 0). */
 } Grades;
 
 /**
  * @struct Course
- * @brief Représente un cours avec son nom, son coefficient et ses notes.
+ * @brief Représente une matière du catalogue de la promotion.
+ *
+ * Le nom et le coefficient d’une matière ne sont stockés qu’une seule fois,
+ * dans `Prom.courses` ; les étudiants y font référence par indice.
  */
 typedef struct Course {
-    Grades* grades;       /**< Pointeur vers la structure contenant les notes du cours. */
     char* course_name;    /**< Nom du cours (chaîne de caractères). */
+    int name_length;      /**< Longueur du nom, pour comparer sans `strcmp()`. */
     float coeff;          /**< Coefficient du cours. */
-    float average;        /**< Moyenne des notes du cours. */
 } Course;
 
+/**
+ * @struct Enrollment
+ * @brief Inscription d’un étudiant à une matière du catalogue, avec ses notes.
+ */
+typedef struct Enrollment {
+    Grades grades;        /**< Notes obtenues par l’étudiant dans ce cours. */
+    float average;        /**< Moyenne des notes du cours. */
+    int course_index;     /**< Indice du cours dans `Prom.courses`. */
+} Enrollment;
+
 /**
  * @struct Student
  * @brief Représente un étudiant et ses informations personnelles ainsi que ses cours suivis.
  */
 typedef struct Student {
-    Course** courses;       /**< Tableau dynamique de pointeurs vers les cours suivis. */
+    Enrollment* courses;    /**< Tableau dynamique des inscriptions aux cours suivis. */
     char* first_name;       /**< Prénom de l’étudiant. */
-    char* last_name;        /**< Nom de l’étudiant. */
+    char* last_name;        /**< Nom de l’étudiant (stocké à la suite du prénom, même allocation). */
     float general_average;  /**< Moyenne générale calculée sur l’ensemble des cours. */
     int student_id;         /**< Identifiant unique de l’étudiant. */
     int num_courses;        /**< Nombre de cours suivis par l’étudiant. */
+    int courses_capacity;   /**< Nombre d’inscriptions allouées (croissance géométrique). */
     int age;                /**< Âge de l’étudiant. */
 } Student;
 
+/**
+ * @struct RosterEntry
+ * @brief Inscription vue depuis la matière : l’étudiant et la position de son inscription.
+ */
+typedef struct RosterEntry {
+    Student* student;       /**< Étudiant inscrit. */
+    int enrollment;         /**< Position de l’inscription dans `student->courses` (stable, les inscriptions ne sont qu’ajoutées). */
+} RosterEntry;
+
+/**
+ * @struct CourseRoster
+ * @brief Liste des inscrits d’une matière, dans l’ordre des inscriptions.
+ */
+typedef struct CourseRoster {
+    RosterEntry* entries;   /**< Tableau dynamique des inscrits. */
+    int size;               /**< Nombre d’inscrits. */
+    int capacity;           /**< Nombre d’entrées allouées (croissance géométrique). */
+} CourseRoster;
+
+/**
+ * @struct StudentIndexSlot
+ * @brief Case de l’index de hachage associant un identifiant à la position d’un étudiant.
+ */
+typedef struct StudentIndexSlot {
+    int student_id;         /**< Identifiant de l’étudiant stocké dans la case. */
+    int position;           /**< Position de l’étudiant dans `Prom.students`, -1 si la case est vide. */
+} StudentIndexSlot;
+
 /**
  * @struct Prom
  * @brief Représente une promotion d’étudiants.
@@ -61,6 +120,15 @@ typedef struct Prom {
     Student** students;     /**< Tableau dynamique de pointeurs vers les étudiants. */
     int num_students;       /**< Nombre total d’étudiants dans la promotion. */
     int capacity;           /**< Capacité actuelle du tableau d’étudiants (pour realloc). */
+    StudentIndexSlot* id_index; /**< Index de hachage (adressage ouvert) `student_id` → position. */
+    int index_capacity;     /**< Nombre de cases de l’index (toujours une puissance de 2). */
+    Course* courses;        /**< Catalogue des matières (nom et coefficient stockés une seule fois). */
+    int num_courses;        /**< Nombre de matières du catalogue. */
+    int courses_capacity;   /**< Capacité actuelle du catalogue (pour realloc). */
+    CourseRoster* rosters;  /**< Inscrits de chaque matière, parallèle à `courses` (même capacité). */
+    Arena* arena;           /**< Arène contenant étudiants, noms et notes, ou NULL (allocation classique). */
+    int aggregate_only;     /**< 1 si les notes ne sont pas conservées, seulement leurs agrégats (`LOAD_AGGREGATE_ONLY`). */
+    struct Leaderboards* leaderboards; /**< Classements tenus à jour au fil des ajouts, ou NULL (voir `leaderboard.h`). */
 } Prom;
 
 #endif // STRUCT_H
@@ -3,10 +3,12 @@
  * @brief Implémentation des fonctions de gestion mémoire pour les structures de données.
  *
  * Ce fichier contient les fonctions permettant :
- * - la création et la suppression de notes (`Grades`),
- * - la création et la suppression de cours (`Course`),
+ * - l’initialisation et la libération de notes (`Grades`),
+ * - le catalogue des matières d’une promotion (`Course`),
+ * - l’inscription des étudiants aux matières et l’ajout de notes (`Enrollment`),
  * - la création et la suppression d’étudiants (`Student`),
- * - la création et la suppression de promotions (`Prom`).
+ * - la création et la suppression de promotions (`Prom`),
+ * - l’index de hachage `student_id` → étudiant d’une promotion.
  *
  * Ces fonctions assurent une gestion sûre de la mémoire dynamique
  * et facilitent la manipulation des structures dans le reste du programme.
@@ -16,120 +18,219 @@
 #include <stdlib.h>
 #include <string.h>
 #include "./struct.h"
+#include "./struct_functions.h"
+#include "./arena.h"
+#include "./leaderboard.h"
+#include "./grade_kernels.h"
 
 /**
- * @brief Crée une structure `Grades` et initialise son tableau de notes.
+ * @brief Alloue depuis l’arène si elle existe, sinon avec `malloc()`.
  */
-Grades* createGrade(int size) {
-    Grades* g = malloc(sizeof(Grades));
-    if (g == NULL) {
-        exit(0);
-    }
+static void* promAlloc(Arena* arena, size_t size) {
+    if (arena != NULL)
+        return arenaAlloc(arena, size);
+    return malloc(size);
+}
+
+/**
+ * @brief Agrandit une zone allouée par `promAlloc()`.
+ */
+static void* promRealloc(Arena* arena, void* old, size_t old_size, size_t new_size) {
+    if (arena != NULL)
+        return arenaRealloc(arena, old, old_size, new_size);
+    return realloc(old, new_size);
+}
+
+/**
+ * @brief Convertit une note en dixièmes de point, arrondis au plus proche.
+ */
+int gradeToTenths(float grade) {
+    if (!(grade >= 0.0f && grade <= 20.0f))
+        return -1;   // rejette aussi NaN
+    return (int)(grade * 10.0f + 0.5f);
+}
+
+/**
+ * @brief Convertit une note en dixièmes de point en note sur 20.
+ */
+float tenthsToGrade(int tenths) {
+    return tenths / 10.0f;
+}
+
+/**
+ * @brief Calcule la moyenne d’une structure `Grades` à partir de sa somme entière.
+ */
+float gradesAverage(const Grades* g) {
+    if (g == NULL || g->size == 0)
+        return 0.0f;
+    return (float)(g->sum / (10.0 * g->size));
+}
+
+/**
+ * @brief Initialise une structure `Grades` et alloue son tableau de notes.
+ */
+int initGrades(Grades* g, int size) {
+    if (g == NULL || size < 0)
+        return -1;
 
     g->size = size;
+    g->capacity = size;
+    g->sum = 0;
+    g->min = 0;
+    g->max = 0;
     g->grades_array = NULL;
 
     if (size > 0) {
-        g->grades_array = calloc(size, sizeof(float));
-        if (g->grades_array == NULL) {
-            free(g);
-            exit(1);
-        }
+        g->grades_array = calloc(size, sizeof(uint8_t));
+        if (g->grades_array == NULL)
+            return -1;
     }
-    return g;
+    return 0;
 }
 
 /**
- * @brief Libère la mémoire associée à une structure `Grades`.
+ * @brief Libère le tableau de notes d’une structure `Grades`.
  */
-void destroyGrade(Grades* g) {
+void freeGrades(Grades* g) {
     if (g == NULL)
         return;
     free(g->grades_array);
-    free(g);
+    g->grades_array = NULL;
+    g->size = 0;
+    g->capacity = 0;
+    g->sum = 0;
+    g->min = 0;
+    g->max = 0;
 }
 
 /**
- * @brief Crée une structure `Course` avec un nom, un coefficient et un tableau de notes vide.
+ * @brief Garantit qu’une structure `Grades` peut contenir `capacity` notes sans réallocation.
  */
-Course* createCourse(char* name, float coeff) {
-    Course* c = malloc(sizeof(Course));
-    if (c == NULL) {
-        exit(1);
-    }
+int reserveGrades(Arena* arena, Grades* g, int capacity) {
+    if (g == NULL)
+        return -1;
+    if (capacity <= g->capacity)
+        return 0;
+
+    uint8_t* tmp = promRealloc(arena, g->grades_array, sizeof(uint8_t) * g->capacity, sizeof(uint8_t) * capacity);
+    if (tmp == NULL)
+        return -1;
+
+    g->grades_array = tmp;
+    g->capacity = capacity;
+    return 0;
+}
+
+/**
+ * @brief Ajoute une note à la fin du tableau, en doublant sa capacité si nécessaire.
+ */
+int appendGrade(Arena* arena, Grades* g, uint8_t tenths) {
+    if (g == NULL)
+        return -1;
 
-    c->course_name = malloc(strlen(name) + 1);
-    if (c->course_name == NULL) {
-        free(c);
-        exit(1);
+    if (g->size >= g->capacity) {
+        if (reserveGrades(arena, g, g->capacity > 0 ? g->capacity * 2 : 4) == -1)
+            return -1;
     }
-    strcpy(c->course_name, name);
 
-    c->coeff = coeff;
-    c->grades = createGrade(0);
-    c->average = 0.0f;
+    g->grades_array[g->size] = tenths;
+    accumulateGrade(g, tenths);
+    return 0;
+}
 
-    return c;
+/**
+ * @brief Compte une note dans l’effectif, la somme et les extrêmes, sans la stocker.
+ */
+void accumulateGrade(Grades* g, uint8_t tenths) {
+    if (g->size == 0 || tenths < g->min)
+        g->min = tenths;
+    if (g->size == 0 || tenths > g->max)
+        g->max = tenths;
+    g->size++;
+    g->sum += tenths;
 }
 
 /**
- * @brief Libère la mémoire associée à un cours.
+ * @brief Recalcule la somme et les extrêmes d’une structure `Grades` à partir de son tableau.
  */
-void destroyCourse(Course* c) {
-    if (c == NULL)
-        return;
-    destroyGrade(c->grades);
-    free(c->course_name);
-    free(c);
+static void refreshGradesAggregates(Grades* g) {
+    g->sum = sumGradeTenths(g->grades_array, g->size);
+    g->min = g->max = (g->size > 0) ? g->grades_array[0] : 0;
+    for (int n = 1; n < g->size; n++) {
+        if (g->grades_array[n] < g->min)
+            g->min = g->grades_array[n];
+        if (g->grades_array[n] > g->max)
+            g->max = g->grades_array[n];
+    }
 }
 
 /**
  * @brief Crée un étudiant avec ses informations personnelles et initialise ses cours.
  */
 Student* createStudent(int id, char* first_name, char* last_name, int age, int num_courses) {
+    return createStudentInArena(NULL, id, first_name, last_name, age, num_courses);
+}
+
+/**
+ * @brief Crée un étudiant dans une arène (ou avec `malloc()` si `arena` vaut NULL).
+ */
+Student* createStudentInArena(Arena* arena, int id, char* first_name, char* last_name, int age, int num_courses) {
     if (first_name == NULL || last_name == NULL || num_courses < 0)
         return NULL;
 
-    Student* s = malloc(sizeof(Student));
+    Student* s = createStudentN(arena, id, first_name, strlen(first_name), last_name, strlen(last_name), age);
     if (s == NULL)
         return NULL;
 
-    s->first_name = malloc(strlen(first_name) + 1);
-    if (s->first_name == NULL) {
-        free(s);
-        return NULL;
+    if (num_courses > 0) {
+        if (reserveEnrollments(arena, s, num_courses) == -1) {
+            if (arena == NULL)
+                destroyStudent(s);
+            return NULL;
+        }
+        memset(s->courses, 0, sizeof(Enrollment) * num_courses);
+        s->num_courses = num_courses;
     }
-    strcpy(s->first_name, first_name);
 
-    s->last_name = malloc(strlen(last_name) + 1);
-    if (s->last_name == NULL) {
-        free(s->first_name);
-        free(s);
+    return s;
+}
+
+/**
+ * @brief Crée un étudiant à partir de noms non terminés par `'\0'` (copiés une seule fois).
+ */
+Student* createStudentN(Arena* arena, int id, const char* first_name, size_t first_len,
+                        const char* last_name, size_t last_len, int age) {
+    if (first_name == NULL || last_name == NULL)
+        return NULL;
+
+    Student* s = promAlloc(arena, sizeof(Student));
+    if (s == NULL)
+        return NULL;
+
+    // Prénom et nom partagent la même allocation
+    s->first_name = promAlloc(arena, first_len + last_len + 2);
+    if (s->first_name == NULL) {
+        if (arena == NULL) free(s);
         return NULL;
     }
-    strcpy(s->last_name, last_name);
+    memcpy(s->first_name, first_name, first_len);
+    s->first_name[first_len] = '\0';
+    s->last_name = s->first_name + first_len + 1;
+    memcpy(s->last_name, last_name, last_len);
+    s->last_name[last_len] = '\0';
 
     s->student_id = id;
     s->age = age;
-    s->num_courses = num_courses;
+    s->num_courses = 0;
+    s->courses_capacity = 0;
     s->general_average = 0.0f;
     s->courses = NULL;
 
-    if (num_courses > 0) {
-        s->courses = calloc(num_courses, sizeof(Course*));
-        if (s->courses == NULL) {
-            free(s->first_name);
-            free(s->last_name);
-            free(s);
-            return NULL;
-        }
-    }
-
     return s;
 }
 
 /**
- * @brief Libère la mémoire associée à un étudiant et à ses cours.
+ * @brief Libère la mémoire associée à un étudiant et à ses inscriptions.
  */
 void destroyStudent(Student* s) {
     if (s == NULL)
@@ -137,15 +238,350 @@ void destroyStudent(Student* s) {
 
     if (s->courses != NULL) {
         for (int i = 0; i < s->num_courses; i++)
-            destroyCourse(s->courses[i]);
+            freeGrades(&s->courses[i].grades);
         free(s->courses);
     }
 
+    // Le nom est stocké dans la même allocation que le prénom
     free(s->first_name);
-    free(s->last_name);
     free(s);
 }
 
+/**
+ * @brief Recherche l’inscription d’un étudiant à un cours du catalogue.
+ */
+Enrollment* findEnrollment(Student* s, int course_index) {
+    if (s == NULL)
+        return NULL;
+
+    for (int i = 0; i < s->num_courses; i++) {
+        if (s->courses[i].course_index == course_index)
+            return &s->courses[i];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Garantit qu’un étudiant peut recevoir `capacity` inscriptions sans réallocation.
+ */
+int reserveEnrollments(Arena* arena, Student* s, int capacity) {
+    if (s == NULL)
+        return -1;
+    if (capacity <= s->courses_capacity)
+        return 0;
+
+    Enrollment* tmp = promRealloc(arena, s->courses, sizeof(Enrollment) * s->courses_capacity,
+                                  sizeof(Enrollment) * capacity);
+    if (tmp == NULL)
+        return -1;
+
+    s->courses = tmp;
+    s->courses_capacity = capacity;
+    return 0;
+}
+
+/**
+ * @brief Inscrit un étudiant à un cours du catalogue (inscription vide).
+ */
+Enrollment* enrollStudent(Arena* arena, Student* s, int course_index) {
+    if (s == NULL || course_index < 0)
+        return NULL;
+
+    if (s->num_courses >= s->courses_capacity) {
+        if (reserveEnrollments(arena, s, s->courses_capacity > 0 ? s->courses_capacity * 2 : 4) == -1)
+            return NULL;
+    }
+
+    Enrollment* e = &s->courses[s->num_courses++];
+    e->course_index = course_index;
+    e->average = 0.0f;
+    initGrades(&e->grades, 0);
+    return e;
+}
+
+/**
+ * @brief Ajoute une note à un étudiant et met à jour ses moyennes en temps constant.
+ */
+int addGradeToStudent(Prom* p, Student* s, int course_index, float grade) {
+    int tenths = gradeToTenths(grade);
+    if (tenths < 0)
+        return -1;
+    return addTenthsToStudent(p, s, course_index, (uint8_t)tenths);
+}
+
+/**
+ * @brief Ajoute une note déjà convertie en dixièmes de point.
+ */
+int addTenthsToStudent(Prom* p, Student* s, int course_index, uint8_t tenths) {
+    if (tenths > GRADE_MAX_TENTHS || p == NULL || s == NULL || course_index < 0 || course_index >= p->num_courses)
+        return -1;
+
+    // Si l’étudiant n’est pas encore inscrit → inscription
+    Enrollment* e = findEnrollment(s, course_index);
+    if (e == NULL) {
+        e = addEnrollmentToProm(p, s, course_index);
+        if (e == NULL)
+            return -1;
+    }
+
+    // Ajout de la note (capacité doublée si nécessaire), ou seulement de ses agrégats
+    float old_average = e->average;
+    float old_general = s->general_average;
+    if (p->aggregate_only)
+        accumulateGrade(&e->grades, tenths);
+    else if (appendGrade(p->arena, &e->grades, tenths) == -1)
+        return -1;
+
+    // Moyenne du cours à partir de la somme courante, puis moyenne générale
+    e->average = gradesAverage(&e->grades);
+    updateGeneralAverage(p, s);
+
+    leaderboardsUpdateCourse(p, s, (int)(e - s->courses), old_average);
+    leaderboardsUpdateGeneral(p, s, old_general);
+    return 0;
+}
+
+/**
+ * @brief Recalcule les agrégats des notes d’un étudiant.
+ *
+ * @param recompute_averages Vrai pour recalculer aussi les moyennes de cours et la moyenne générale.
+ */
+static void refreshTotals(const Prom* p, Student* s, int recompute_averages) {
+    if (p == NULL || s == NULL)
+        return;
+
+    for (int i = 0; i < s->num_courses; i++) {
+        Enrollment* e = &s->courses[i];
+        if (!p->aggregate_only)
+            refreshGradesAggregates(&e->grades);
+        if (recompute_averages && e->grades.size > 0)
+            e->average = gradesAverage(&e->grades);
+    }
+    if (recompute_averages)
+        updateGeneralAverage(p, s);
+}
+
+/**
+ * @brief Recalcule les agrégats des notes et les moyennes d’un étudiant.
+ */
+void refreshStudentTotals(const Prom* p, Student* s) {
+    refreshTotals(p, s, 1);
+}
+
+/**
+ * @brief Recalcule les agrégats des notes d’un étudiant en gardant ses moyennes.
+ */
+void refreshStudentSums(const Prom* p, Student* s) {
+    refreshTotals(p, s, 0);
+}
+
+/**
+ * @brief Recalcule la moyenne générale d’un étudiant à partir des moyennes de ses cours.
+ */
+void updateGeneralAverage(const Prom* p, Student* s) {
+    if (p == NULL || s == NULL)
+        return;
+
+    float total = 0, total_coeff = 0;
+    for (int i = 0; i < s->num_courses; i++) {
+        if (s->courses[i].grades.size == 0)
+            continue;
+        float coeff = p->courses[s->courses[i].course_index].coeff;
+        total += s->courses[i].average * coeff;
+        total_coeff += coeff;
+    }
+    if (total_coeff > 0)
+        s->general_average = total / total_coeff;
+}
+
+/**
+ * @brief Recherche une matière du catalogue par son nom.
+ */
+int findCourseByName(const Prom* p, const char* name) {
+    if (name == NULL)
+        return -1;
+    return findCourseByNameN(p, name, strlen(name));
+}
+
+/**
+ * @brief Recherche une matière du catalogue par un nom non terminé par `'\0'`.
+ */
+int findCourseByNameN(const Prom* p, const char* name, size_t len) {
+    if (p == NULL || name == NULL)
+        return -1;
+
+    for (int i = 0; i < p->num_courses; i++) {
+        const Course* c = &p->courses[i];
+        if (c->name_length == (int)len && memcmp(c->course_name, name, len) == 0)
+            return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Ajoute une matière au catalogue de la promotion.
+ */
+int addCourseToProm(Prom* p, const char* name, float coeff) {
+    if (name == NULL)
+        return -1;
+    return addCourseToPromN(p, name, strlen(name), coeff);
+}
+
+/**
+ * @brief Ajoute une matière au catalogue à partir d’un nom non terminé par `'\0'`.
+ */
+int addCourseToPromN(Prom* p, const char* name, size_t len, float coeff) {
+    if (p == NULL || name == NULL)
+        return -1;
+
+    int existing = findCourseByNameN(p, name, len);
+    if (existing != -1)
+        return existing;
+
+    if (p->num_courses >= p->courses_capacity) {
+        int new_capacity = p->courses_capacity > 0 ? p->courses_capacity * 2 : 16;
+        Course* tmp = realloc(p->courses, sizeof(Course) * new_capacity);
+        if (tmp == NULL)
+            return -1;
+        p->courses = tmp;
+
+        CourseRoster* rosters = realloc(p->rosters, sizeof(CourseRoster) * new_capacity);
+        if (rosters == NULL)
+            return -1;
+        p->rosters = rosters;
+        p->courses_capacity = new_capacity;
+    }
+
+    Course* c = &p->courses[p->num_courses];
+    c->course_name = promAlloc(p->arena, len + 1);
+    if (c->course_name == NULL)
+        return -1;
+    memcpy(c->course_name, name, len);
+    c->course_name[len] = '\0';
+    c->name_length = (int)len;
+    c->coeff = coeff;
+    p->rosters[p->num_courses] = (CourseRoster){ NULL, 0, 0 };
+    p->num_courses++;
+
+    leaderboardsAddCourse(p);
+    return p->num_courses - 1;
+}
+
+/**
+ * @brief Modifie le coefficient d’une matière et met à jour les moyennes générales concernées.
+ */
+int setCourseCoeff(Prom* p, int course_index, float coeff) {
+    if (p == NULL || course_index < 0 || course_index >= p->num_courses)
+        return -1;
+
+    p->courses[course_index].coeff = coeff;
+    const CourseRoster* roster = &p->rosters[course_index];
+    for (int i = 0; i < roster->size; i++) {
+        Student* s = roster->entries[i].student;
+        float old_general = s->general_average;
+        updateGeneralAverage(p, s);
+        leaderboardsUpdateGeneral(p, s, old_general);
+    }
+    return 0;
+}
+
+/**
+ * @brief Garantit que la liste des inscrits d’une matière peut contenir `capacity` entrées.
+ */
+int reserveCourseRoster(Prom* p, int course_index, int capacity) {
+    if (p == NULL || course_index < 0 || course_index >= p->num_courses)
+        return -1;
+
+    CourseRoster* roster = &p->rosters[course_index];
+    if (capacity <= roster->capacity)
+        return 0;
+
+    RosterEntry* tmp = realloc(roster->entries, sizeof(RosterEntry) * capacity);
+    if (tmp == NULL)
+        return -1;
+    roster->entries = tmp;
+    roster->capacity = capacity;
+    return 0;
+}
+
+/**
+ * @brief Inscrit un étudiant de la promotion à une matière et l’ajoute à la liste des inscrits.
+ */
+Enrollment* addEnrollmentToProm(Prom* p, Student* s, int course_index) {
+    if (p == NULL || s == NULL || course_index < 0 || course_index >= p->num_courses)
+        return NULL;
+
+    CourseRoster* roster = &p->rosters[course_index];
+    if (roster->size >= roster->capacity &&
+        reserveCourseRoster(p, course_index, roster->capacity > 0 ? roster->capacity * 2 : 16) == -1)
+        return NULL;
+
+    Enrollment* e = enrollStudent(p->arena, s, course_index);
+    if (e == NULL)
+        return NULL;
+
+    roster->entries[roster->size++] = (RosterEntry){ s, s->num_courses - 1 };
+    leaderboardsAddEnrollment(p, s, s->num_courses - 1);
+    return e;
+}
+
+/**
+ * @brief Calcule la case de départ d’un identifiant dans l’index (hachage de Fibonacci).
+ */
+static int hashStudentId(int id, int index_capacity) {
+    unsigned int h = (unsigned int)id * 2654435769u;
+    h ^= h >> 16;
+    return (int)(h & (unsigned int)(index_capacity - 1));
+}
+
+/**
+ * @brief Insère une position dans l’index sans vérifier le taux de remplissage.
+ *
+ * Si l’identifiant est déjà présent, la première occurrence est conservée
+ * (même comportement que l’ancien parcours linéaire).
+ */
+static void insertInIndex(StudentIndexSlot* slots, int index_capacity, int id, int position) {
+    int h = hashStudentId(id, index_capacity);
+    while (slots[h].position != -1) {
+        if (slots[h].student_id == id)
+            return;
+        h = (h + 1) & (index_capacity - 1);
+    }
+    slots[h].student_id = id;
+    slots[h].position = position;
+}
+
+/**
+ * @brief Alloue un index vide de `index_capacity` cases.
+ */
+static StudentIndexSlot* allocIndex(int index_capacity) {
+    StudentIndexSlot* slots = malloc(sizeof(StudentIndexSlot) * index_capacity);
+    if (slots == NULL)
+        return NULL;
+    for (int i = 0; i < index_capacity; i++)
+        slots[i].position = -1;
+    return slots;
+}
+
+/**
+ * @brief Double la taille de l’index et y réinsère tous les étudiants.
+ * @return 0 si succès, -1 en cas d’échec d’allocation.
+ */
+static int growIndex(Prom* p) {
+    int new_capacity = p->index_capacity * 2;
+    StudentIndexSlot* slots = allocIndex(new_capacity);
+    if (slots == NULL)
+        return -1;
+
+    for (int i = 0; i < p->num_students; i++)
+        insertInIndex(slots, new_capacity, p->students[i]->student_id, i);
+
+    free(p->id_index);
+    p->id_index = slots;
+    p->index_capacity = new_capacity;
+    return 0;
+}
+
 /**
  * @brief Crée une structure `Prom` représentant une promotion.
  */
@@ -160,6 +596,13 @@ Prom* createProm(int initial_capacity, int nb_students) {
     p->num_students = nb_students;
     p->capacity = initial_capacity;
     p->students = NULL;
+    p->courses = NULL;
+    p->num_courses = 0;
+    p->courses_capacity = 0;
+    p->rosters = NULL;
+    p->arena = NULL;
+    p->aggregate_only = 0;
+    p->leaderboards = NULL;
 
     if (initial_capacity > 0) {
         p->students = calloc(initial_capacity, sizeof(Student*));
@@ -169,6 +612,87 @@ Prom* createProm(int initial_capacity, int nb_students) {
         }
     }
 
+    // Index dimensionné pour rester à moins de 50 % de remplissage
+    p->index_capacity = 16;
+    while (p->index_capacity < initial_capacity * 2)
+        p->index_capacity *= 2;
+
+    p->id_index = allocIndex(p->index_capacity);
+    if (p->id_index == NULL) {
+        free(p->students);
+        free(p);
+        return NULL;
+    }
+
+    return p;
+}
+
+/**
+ * @brief Ajoute un étudiant à la fin de la promotion et l’enregistre dans l’index.
+ */
+int addStudentToProm(Prom* p, Student* s) {
+    if (p == NULL || s == NULL)
+        return -1;
+
+    if (p->num_students >= p->capacity) {
+        int new_capacity = p->capacity > 0 ? p->capacity * 2 : 16;
+        Student** tmp = realloc(p->students, sizeof(Student*) * new_capacity);
+        if (tmp == NULL)
+            return -1;
+        p->students = tmp;
+        p->capacity = new_capacity;
+    }
+
+    if ((p->num_students + 1) * 2 > p->index_capacity) {
+        if (growIndex(p) == -1)
+            return -1;
+    }
+
+    insertInIndex(p->id_index, p->index_capacity, s->student_id, p->num_students);
+    p->students[p->num_students++] = s;
+    leaderboardsAddStudent(p, s);
+    return 0;
+}
+
+/**
+ * @brief Recherche la position d’un étudiant par identifiant grâce à l’index de hachage.
+ */
+int findStudentPosition(const Prom* p, int id) {
+    if (p == NULL || p->id_index == NULL)
+        return -1;
+
+    int h = hashStudentId(id, p->index_capacity);
+    while (p->id_index[h].position != -1) {
+        if (p->id_index[h].student_id == id)
+            return p->id_index[h].position;
+        h = (h + 1) & (p->index_capacity - 1);
+    }
+    return -1;
+}
+
+/**
+ * @brief Recherche un étudiant par identifiant grâce à l’index de hachage.
+ */
+Student* findStudentById(const Prom* p, int id) {
+    int position = findStudentPosition(p, id);
+    if (position == -1)
+        return NULL;
+    return p->students[position];
+}
+
+/**
+ * @brief Crée une promotion dont les étudiants, noms et notes sont alloués dans une arène.
+ */
+Prom* createArenaProm(int initial_capacity) {
+    Prom* p = createProm(initial_capacity, 0);
+    if (p == NULL)
+        return NULL;
+
+    p->arena = createArena(0);
+    if (p->arena == NULL) {
+        destroyProm(p);
+        return NULL;
+    }
     return p;
 }
 
@@ -179,11 +703,26 @@ void destroyProm(Prom* p) {
     if (p == NULL)
         return;
 
-    if (p->students != NULL) {
+    disableLeaderboards(p);
+
+    // En mode arène, étudiants, noms, inscriptions et notes partent avec les blocs de l’arène
+    if (p->students != NULL && p->arena == NULL) {
         for (int i = 0; i < p->num_students; i++)
             destroyStudent(p->students[i]);
-        free(p->students);
     }
+    free(p->students);
+
+    if (p->courses != NULL && p->arena == NULL) {
+        for (int i = 0; i < p->num_courses; i++)
+            free(p->courses[i].course_name);
+    }
+    free(p->courses);
+
+    for (int i = 0; p->rosters != NULL && i < p->num_courses; i++)
+        free(p->rosters[i].entries);
+    free(p->rosters);
 
+    destroyArena(p->arena);
+    free(p->id_index);
     free(p);
 }
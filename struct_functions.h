@@ -5,7 +5,8 @@
  * Ce module fournit un ensemble de fonctions utilitaires pour allouer, initialiser
  * et libérer la mémoire associée aux structures :
  * - `Grades`
- * - `Course`
+ * - `Course` (catalogue des matières de la promotion)
+ * - `Enrollment`
  * - `Student`
  * - `Prom`
  *
@@ -19,37 +20,81 @@
 #define STRUCT_FUNCTIONS_H
 
 #include "./struct.h"
+#include "./arena.h"
 
 /**
- * @brief Crée une structure `Grades` et initialise son tableau de notes.
+ * @brief Convertit une note en dixièmes de point, arrondis au plus proche.
+ *
+ * @param grade Note sur 20.
+ * @return La note en dixièmes (0 à `GRADE_MAX_TENTHS`), ou -1 si elle est hors de l’intervalle 0–20.
+ */
+int gradeToTenths(float grade);
+
+/**
+ * @brief Convertit une note en dixièmes de point en note sur 20.
+ *
+ * @param tenths Note en dixièmes.
+ * @return La note sur 20.
+ */
+float tenthsToGrade(int tenths);
+
+/**
+ * @brief Calcule la moyenne d’une structure `Grades` à partir de sa somme entière.
+ *
+ * @param g Notes du cours.
+ * @return La moyenne sur 20, ou 0 s’il n’y a aucune note.
+ */
+float gradesAverage(const Grades* g);
+
+/**
+ * @brief Initialise une structure `Grades` et alloue son tableau de notes.
  * 
+ * @param g    Structure à initialiser.
  * @param size Nombre initial de notes à allouer (0 pour un tableau vide).
- * @return Pointeur vers la structure allouée, ou NULL en cas d’échec.
+ * @return 0 si succès, -1 en cas d’échec.
  */
-Grades* createGrade(int size);
+int initGrades(Grades* g, int size);
 
 /**
- * @brief Libère la mémoire associée à une structure `Grades`.
+ * @brief Libère le tableau de notes d’une structure `Grades` et la remet à zéro.
  * 
- * @param g Pointeur vers la structure à détruire.
+ * @param g Pointeur vers la structure à vider.
  */
-void destroyGrade(Grades* g);
+void freeGrades(Grades* g);
 
 /**
- * @brief Crée une structure `Course` et initialise son nom, coefficient et tableau de notes.
+ * @brief Garantit qu’une structure `Grades` peut contenir `capacity` notes sans réallocation.
+ *
+ * Utilisée par le pré-dimensionnement du chargement pour allouer chaque tableau une seule fois.
  * 
- * @param name   Nom du cours.
- * @param coeff  Coefficient associé au cours.
- * @return Pointeur vers la structure allouée, ou NULL en cas d’erreur.
+ * @param arena    Arène de la promotion, ou NULL pour une allocation classique.
+ * @param g        Structure à agrandir.
+ * @param capacity Nombre de notes à pouvoir stocker.
+ * @return 0 si succès, -1 en cas d’échec d’allocation.
  */
-Course* createCourse(char* name, float coeff);
+int reserveGrades(Arena* arena, Grades* g, int capacity);
 
 /**
- * @brief Libère la mémoire associée à un cours.
+ * @brief Ajoute une note à la fin d’une structure `Grades` et met à jour sa somme courante et ses extrêmes.
+ *
+ * La capacité est doublée lorsque le tableau est plein (coût amorti constant).
  * 
- * @param c Pointeur vers le cours à détruire.
+ * @param arena Arène de la promotion, ou NULL pour une allocation classique.
+ * @param g      Structure à compléter.
+ * @param tenths Note à ajouter, en dixièmes de point.
+ * @return 0 si succès, -1 en cas d’échec d’allocation.
+ */
+int appendGrade(Arena* arena, Grades* g, uint8_t tenths);
+
+/**
+ * @brief Compte une note dans l’effectif, la somme et les extrêmes d’une structure `Grades`, sans la stocker.
+ *
+ * Utilisée seule pour les promotions chargées avec `LOAD_AGGREGATE_ONLY`.
+ *
+ * @param g      Structure à compléter.
+ * @param tenths Note à compter, en dixièmes de point.
  */
-void destroyCourse(Course* c);
+void accumulateGrade(Grades* g, uint8_t tenths);
 
 /**
  * @brief Crée une structure `Student` avec ses informations personnelles et ses cours.
@@ -64,12 +109,224 @@ void destroyCourse(Course* c);
 Student* createStudent(int id, char* first_name, char* last_name, int age, int num_courses);
 
 /**
- * @brief Libère toute la mémoire associée à un étudiant (cours, chaînes, structure).
+ * @brief Crée un étudiant dont la structure, les noms et les inscriptions sont alloués dans une arène.
+ *
+ * Un étudiant créé dans une arène ne doit pas être passé à `destroyStudent()` :
+ * il est libéré avec l’arène, par `destroyProm()`.
+ * 
+ * @param arena        Arène de la promotion, ou NULL (équivalent à `createStudent()`).
+ * @param id           Identifiant de l’étudiant.
+ * @param first_name   Prénom de l’étudiant.
+ * @param last_name    Nom de l’étudiant.
+ * @param age          Âge de l’étudiant.
+ * @param num_courses  Nombre de cours suivis (0 pour aucun).
+ * @return Pointeur vers la structure allouée, ou NULL en cas d’échec.
+ */
+Student* createStudentInArena(Arena* arena, int id, char* first_name, char* last_name, int age, int num_courses);
+
+/**
+ * @brief Crée un étudiant sans cours à partir de noms donnés par pointeur et longueur.
+ *
+ * Les noms n’ont pas besoin d’être terminés par `'\0'` : ils peuvent pointer
+ * directement dans le tampon de lecture. Ils sont copiés une seule fois, dans une
+ * allocation commune au prénom et au nom.
+ * 
+ * @param arena      Arène de la promotion, ou NULL pour une allocation classique.
+ * @param id         Identifiant de l’étudiant.
+ * @param first_name Début du prénom.
+ * @param first_len  Longueur du prénom.
+ * @param last_name  Début du nom.
+ * @param last_len   Longueur du nom.
+ * @param age        Âge de l’étudiant.
+ * @return Pointeur vers la structure allouée, ou NULL en cas d’échec.
+ */
+Student* createStudentN(Arena* arena, int id, const char* first_name, size_t first_len,
+                        const char* last_name, size_t last_len, int age);
+
+/**
+ * @brief Libère toute la mémoire associée à un étudiant (inscriptions, chaînes, structure).
  * 
  * @param s Pointeur vers l’étudiant à détruire.
  */
 void destroyStudent(Student* s);
 
+/**
+ * @brief Recherche l’inscription d’un étudiant à un cours du catalogue.
+ * 
+ * @param s            Pointeur vers l’étudiant.
+ * @param course_index Indice du cours dans le catalogue de la promotion.
+ * @return Pointeur vers l’inscription, ou NULL si l’étudiant ne suit pas ce cours.
+ */
+Enrollment* findEnrollment(Student* s, int course_index);
+
+/**
+ * @brief Garantit qu’un étudiant peut recevoir `capacity` inscriptions sans réallocation.
+ * 
+ * @param arena    Arène de la promotion, ou NULL pour une allocation classique.
+ * @param s        Pointeur vers l’étudiant.
+ * @param capacity Nombre d’inscriptions à pouvoir stocker.
+ * @return 0 si succès, -1 en cas d’échec d’allocation.
+ */
+int reserveEnrollments(Arena* arena, Student* s, int capacity);
+
+/**
+ * @brief Inscrit un étudiant à un cours du catalogue, sans aucune note.
+ * 
+ * @param arena        Arène de la promotion, ou NULL pour une allocation classique.
+ * @param s            Pointeur vers l’étudiant.
+ * @param course_index Indice du cours dans le catalogue de la promotion.
+ * @return Pointeur vers la nouvelle inscription, ou NULL en cas d’échec.
+ *
+ * @note Le pointeur retourné est invalidé si le tableau d’inscriptions doit être agrandi.
+ * @note Pour un étudiant d’une promotion, utiliser `addEnrollmentToProm()`, qui tient
+ *       aussi à jour la liste des inscrits de la matière.
+ */
+Enrollment* enrollStudent(Arena* arena, Student* s, int course_index);
+
+/**
+ * @brief Ajoute une note à un étudiant dans un cours, en l’y inscrivant si nécessaire.
+ *
+ * Met à jour la moyenne du cours en temps constant, grâce à la somme courante des
+ * notes (`Grades.sum`), puis la moyenne générale avec `updateGeneralAverage()`, en
+ * un passage sur les cours suivis : la valeur est celle d’un chargement complet, au
+ * bit près. Si la promotion tient des classements (`enableLeaderboards()`),
+ * l’étudiant y est replacé en O(log n).
+ * 
+ * @param p            Promotion contenant le catalogue des matières.
+ * @param s            Étudiant concerné.
+ * @param course_index Indice du cours dans le catalogue.
+ * @param grade        Note à ajouter, arrondie au dixième.
+ * @return 0 si succès, -1 en cas d’erreur (dont une note hors de l’intervalle 0–20).
+ */
+int addGradeToStudent(Prom* p, Student* s, int course_index, float grade);
+
+/**
+ * @brief Ajoute une note déjà convertie en dixièmes de point (voir `addGradeToStudent()`).
+ *
+ * @param p            Promotion contenant le catalogue des matières.
+ * @param s            Étudiant concerné.
+ * @param course_index Indice du cours dans le catalogue.
+ * @param tenths       Note à ajouter, en dixièmes (au plus `GRADE_MAX_TENTHS`).
+ * @return 0 si succès, -1 en cas d’erreur.
+ */
+int addTenthsToStudent(Prom* p, Student* s, int course_index, uint8_t tenths);
+
+/**
+ * @brief Recalcule les agrégats des notes, les moyennes de cours et la moyenne générale d’un étudiant.
+ *
+ * À appeler lorsque les notes ont été renseignées directement (restauration binaire
+ * par exemple), avant tout nouvel appel à `addGradeToStudent()`. Dans une promotion
+ * `aggregate_only`, les sommes des notes sont gardées telles quelles.
+ * 
+ * @param p Promotion contenant le catalogue des matières.
+ * @param s Étudiant dont les totaux sont recalculés.
+ */
+void refreshStudentTotals(const Prom* p, Student* s);
+
+/**
+ * @brief Recalcule les agrégats des notes d’un étudiant sans toucher à ses moyennes.
+ *
+ * Variante de `refreshStudentTotals()` pour une restauration : les moyennes lues
+ * dans la sauvegarde sont gardées telles quelles (elles peuvent différer au dernier
+ * bit de celles recalculées à partir des notes).
+ *
+ * @param p Promotion contenant le catalogue des matières.
+ * @param s Étudiant dont les totaux sont recalculés.
+ */
+void refreshStudentSums(const Prom* p, Student* s);
+
+/**
+ * @brief Recalcule la moyenne générale d’un étudiant en un seul passage sur ses cours.
+ *
+ * Seule définition de la moyenne générale : les moyennes de cours pondérées sont
+ * accumulées en `float` dans l’ordre des inscriptions, comme dans les versions
+ * précédentes. `addGradeToStudent()`, `setCourseCoeff()` et le chargement passent
+ * tous par elle. Sans cours noté (ou de coefficient non nul), la moyenne est gardée.
+ * 
+ * @param p Promotion contenant le catalogue des matières.
+ * @param s Étudiant dont la moyenne générale est recalculée.
+ */
+void updateGeneralAverage(const Prom* p, Student* s);
+
+/**
+ * @brief Recherche une matière du catalogue par son nom.
+ * 
+ * @param p    Pointeur vers la promotion.
+ * @param name Nom de la matière.
+ * @return Indice de la matière dans `p->courses`, ou -1 si elle n’existe pas.
+ */
+int findCourseByName(const Prom* p, const char* name);
+
+/**
+ * @brief Recherche une matière du catalogue par un nom donné par pointeur et longueur.
+ * 
+ * @param p    Pointeur vers la promotion.
+ * @param name Début du nom (pas nécessairement terminé par `'\0'`).
+ * @param len  Longueur du nom.
+ * @return Indice de la matière dans `p->courses`, ou -1 si elle n’existe pas.
+ */
+int findCourseByNameN(const Prom* p, const char* name, size_t len);
+
+/**
+ * @brief Ajoute une matière au catalogue de la promotion.
+ *
+ * Le nom est copié une seule fois. Si une matière du même nom existe déjà,
+ * son indice est retourné et le catalogue n’est pas modifié.
+ * 
+ * @param p     Pointeur vers la promotion.
+ * @param name  Nom de la matière.
+ * @param coeff Coefficient de la matière.
+ * @return Indice de la matière dans le catalogue, ou -1 en cas d’erreur.
+ */
+int addCourseToProm(Prom* p, const char* name, float coeff);
+
+/**
+ * @brief Ajoute une matière au catalogue à partir d’un nom donné par pointeur et longueur.
+ * 
+ * @param p     Pointeur vers la promotion.
+ * @param name  Début du nom (pas nécessairement terminé par `'\0'`).
+ * @param len   Longueur du nom.
+ * @param coeff Coefficient de la matière.
+ * @return Indice de la matière dans le catalogue, ou -1 en cas d’erreur.
+ */
+int addCourseToPromN(Prom* p, const char* name, size_t len, float coeff);
+
+/**
+ * @brief Modifie le coefficient d’une matière du catalogue.
+ *
+ * La moyenne générale de chaque étudiant inscrit à la matière est recalculée, avec
+ * le même résultat qu’un rechargement utilisant le nouveau coefficient.
+ *
+ * @param p            Pointeur vers la promotion.
+ * @param course_index Indice de la matière dans le catalogue.
+ * @param coeff        Nouveau coefficient.
+ * @return 0 si succès, -1 si l’indice est invalide.
+ */
+int setCourseCoeff(Prom* p, int course_index, float coeff);
+
+/**
+ * @brief Garantit que la liste des inscrits d’une matière peut contenir `capacity` entrées sans réallocation.
+ *
+ * @param p            Pointeur vers la promotion.
+ * @param course_index Indice de la matière dans le catalogue.
+ * @param capacity     Nombre d’inscrits à pouvoir stocker.
+ * @return 0 si succès, -1 en cas d’erreur.
+ */
+int reserveCourseRoster(Prom* p, int course_index, int capacity);
+
+/**
+ * @brief Inscrit un étudiant de la promotion à une matière et l’ajoute à la liste des inscrits.
+ *
+ * @param p            Pointeur vers la promotion.
+ * @param s            Étudiant de la promotion.
+ * @param course_index Indice de la matière dans le catalogue.
+ * @return Pointeur vers la nouvelle inscription, ou NULL en cas d’échec.
+ *
+ * @note Comme pour `enrollStudent()`, le pointeur retourné est invalidé si le tableau
+ *       d’inscriptions de l’étudiant doit être agrandi.
+ */
+Enrollment* addEnrollmentToProm(Prom* p, Student* s, int course_index);
+
 /**
  * @brief Crée une structure `Prom` représentant une promotion d’étudiants.
  * 
@@ -80,7 +337,56 @@ void destroyStudent(Student* s);
 Prom* createProm(int initial_capacity, int nb_students);
 
 /**
- * @brief Libère toute la mémoire associée à une promotion (étudiants, tableau, structure).
+ * @brief Crée une promotion en mode arène.
+ *
+ * Étudiants, noms, noms de cours, inscriptions et notes sont découpés dans de grands
+ * blocs mémoire ; `destroyProm()` libère alors toute la promotion en quelques appels
+ * à `free()` au lieu de parcourir chaque étudiant.
+ * 
+ * @param initial_capacity Taille initiale du tableau d’étudiants.
+ * @return Pointeur vers la promotion, ou NULL en cas d’échec.
+ */
+Prom* createArenaProm(int initial_capacity);
+
+/**
+ * @brief Ajoute un étudiant à la fin d’une promotion et l’enregistre dans l’index de hachage.
+ *
+ * Le tableau d’étudiants et l’index sont agrandis automatiquement si nécessaire.
+ * La promotion devient propriétaire de l’étudiant. Pour une promotion en mode arène,
+ * l’étudiant doit avoir été créé avec `createStudentInArena(p->arena, ...)`.
+ *
+ * @param p Pointeur vers la promotion.
+ * @param s Étudiant à ajouter.
+ * @return 0 si succès, -1 en cas d’erreur d’allocation ou d’argument invalide.
+ */
+int addStudentToProm(Prom* p, Student* s);
+
+/**
+ * @brief Recherche la position d’un étudiant dans `p->students` par son identifiant.
+ *
+ * Même recherche que `findStudentById()`, utile pour indexer des tableaux parallèles
+ * à la promotion.
+ *
+ * @param p  Pointeur vers la promotion.
+ * @param id Identifiant de l’étudiant recherché.
+ * @return Position de l’étudiant, ou -1 s’il n’existe pas.
+ */
+int findStudentPosition(const Prom* p, int id);
+
+/**
+ * @brief Recherche un étudiant par son identifiant en temps constant (en moyenne).
+ *
+ * Utilise l’index de hachage à adressage ouvert maintenu par `addStudentToProm()`.
+ * En cas d’identifiants dupliqués, le premier étudiant ajouté est retourné.
+ *
+ * @param p  Pointeur vers la promotion.
+ * @param id Identifiant de l’étudiant recherché.
+ * @return Pointeur vers l’étudiant, ou NULL s’il n’existe pas.
+ */
+Student* findStudentById(const Prom* p, int id);
+
+/**
+ * @brief Libère toute la mémoire associée à une promotion (étudiants, catalogue, index, structure).
  * 
  * @param p Pointeur vers la promotion à détruire.
  */
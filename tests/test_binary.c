@@ -0,0 +1,140 @@
+/**
+ * @file test_binary.c
+ * @brief Test d’aller-retour de la sauvegarde binaire v1 sur le fichier `save.bin` du dépôt.
+ *
+ * `save.bin` est relu, puis sauvegardé aux formats historique et compact :
+ * - la sauvegarde au format historique doit être identique, octet pour octet, à `save.bin` ;
+ * - les deux sauvegardes, relues, doivent redonner exactement la promotion de départ.
+ *
+ * Usage : `test_binary <dossier_temporaire>`, lancé depuis la racine du dépôt (`make test`).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../struct.h"
+#include "../struct_functions.h"
+#include "../file_gestion.h"
+
+/** @brief Fichier de référence, à la racine du dépôt. */
+#define FIXTURE "save.bin"
+
+static int failures = 0;
+
+/** @brief Signale un échec si la condition est fausse. */
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "ÉCHEC %s:%d : ", __FILE__, __LINE__); \
+        fprintf(stderr, __VA_ARGS__); \
+        fprintf(stderr, "\n"); \
+        failures++; \
+    } \
+} while (0)
+
+/**
+ * @brief Lit un fichier entier.
+ * @return Le contenu alloué (à libérer), ou NULL.
+ */
+static unsigned char* readFile(const char* filename, size_t* size) {
+    FILE* f = fopen(filename, "rb");
+    if (f == NULL)
+        return NULL;
+    fseek(f, 0, SEEK_END);
+    long length = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    unsigned char* data = malloc(length > 0 ? (size_t)length : 1);
+    if (data != NULL && fread(data, 1, (size_t)length, f) != (size_t)length) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    *size = (size_t)length;
+    return data;
+}
+
+/**
+ * @brief Compare deux promotions champ par champ (flottants au bit près).
+ */
+static void checkSameProm(const Prom* a, const Prom* b, const char* label) {
+    CHECK(a->num_students == b->num_students, "%s : %d étudiants au lieu de %d", label, b->num_students, a->num_students);
+    if (a->num_students != b->num_students)
+        return;
+
+    for (int i = 0; i < a->num_students; i++) {
+        const Student* x = a->students[i];
+        const Student* y = b->students[i];
+        CHECK(x->student_id == y->student_id && x->age == y->age
+              && strcmp(x->first_name, y->first_name) == 0 && strcmp(x->last_name, y->last_name) == 0,
+              "%s : étudiant %d différent", label, x->student_id);
+        CHECK(memcmp(&x->general_average, &y->general_average, sizeof(float)) == 0,
+              "%s : moyenne générale de %d différente", label, x->student_id);
+        CHECK(x->num_courses == y->num_courses, "%s : inscriptions de %d différentes", label, x->student_id);
+        if (x->num_courses != y->num_courses)
+            continue;
+
+        for (int j = 0; j < x->num_courses; j++) {
+            const Enrollment* e = &x->courses[j];
+            const Enrollment* f = &y->courses[j];
+            const Course* c = &a->courses[e->course_index];
+            const Course* d = &b->courses[f->course_index];
+            CHECK(strcmp(c->course_name, d->course_name) == 0 && memcmp(&c->coeff, &d->coeff, sizeof(float)) == 0,
+                  "%s : cours %d de %d différent", label, j, x->student_id);
+            CHECK(memcmp(&e->average, &f->average, sizeof(float)) == 0,
+                  "%s : moyenne de %s pour %d différente", label, c->course_name, x->student_id);
+            CHECK(e->grades.size == f->grades.size
+                  && memcmp(e->grades.grades_array, f->grades.grades_array, (size_t)e->grades.size) == 0,
+                  "%s : notes de %s pour %d différentes", label, c->course_name, x->student_id);
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage : %s <dossier_temporaire>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    char default_file[1024], compact_file[1024];
+    snprintf(default_file, sizeof(default_file), "%s/roundtrip_default.bin", argv[1]);
+    snprintf(compact_file, sizeof(compact_file), "%s/roundtrip_compact.bin", argv[1]);
+
+    Prom* p = loadPromotionFromBinaryFile(FIXTURE);
+    CHECK(p != NULL && p->num_students > 0, "lecture de %s impossible", FIXTURE);
+    if (p == NULL)
+        return EXIT_FAILURE;
+
+    // Format historique : même fichier, octet pour octet
+    CHECK(saveInBinaryFileEx(default_file, p, SAVE_DEFAULT) == 0, "sauvegarde de %s impossible", default_file);
+    size_t size_ref = 0, size_out = 0;
+    unsigned char* ref = readFile(FIXTURE, &size_ref);
+    unsigned char* out = readFile(default_file, &size_out);
+    CHECK(ref != NULL && out != NULL && size_ref == size_out && memcmp(ref, out, size_ref) == 0,
+          "%s diffère de %s (%zu octets au lieu de %zu)", default_file, FIXTURE, size_out, size_ref);
+    free(ref);
+    free(out);
+
+    Prom* reloaded = loadPromotionFromBinaryFile(default_file);
+    CHECK(reloaded != NULL, "relecture de %s impossible", default_file);
+    if (reloaded != NULL)
+        checkSameProm(p, reloaded, "format historique");
+    destroyProm(reloaded);
+
+    // Format compact : même contenu une fois relu
+    CHECK(saveInBinaryFileEx(compact_file, p, SAVE_COMPACT) == 0, "sauvegarde de %s impossible", compact_file);
+    reloaded = loadPromotionFromBinaryFileEx(compact_file, LOAD_ARENA);
+    CHECK(reloaded != NULL, "relecture de %s impossible", compact_file);
+    if (reloaded != NULL)
+        checkSameProm(p, reloaded, "format compact");
+    destroyProm(reloaded);
+
+    destroyProm(p);
+    remove(default_file);
+    remove(compact_file);
+
+    if (failures > 0) {
+        fprintf(stderr, "test_binary : %d échec(s)\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("test_binary : OK\n");
+    return EXIT_SUCCESS;
+}
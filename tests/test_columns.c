@@ -0,0 +1,86 @@
+/**
+ * @file test_columns.c
+ * @brief Représentation en colonnes : moyennes recalculées identiques à celles de la promotion.
+ *
+ * Les colonnes de `data.txt` sont recalculées à partir des notes : moyennes de cours et
+ * moyennes générales doivent rester celles de la promotion, au bit près. Après un même
+ * changement de coefficient, colonnes et promotion doivent encore être d’accord.
+ *
+ * Usage : `test_columns <dossier_temporaire>`, lancé depuis la racine du dépôt (`make test`).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../struct.h"
+#include "../struct_functions.h"
+#include "../file_gestion.h"
+#include "../prom_columns.h"
+
+static int failures = 0;
+
+/** @brief Signale un échec si la condition est fausse. */
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "ÉCHEC %s:%d : ", __FILE__, __LINE__); \
+        fprintf(stderr, __VA_ARGS__); \
+        fprintf(stderr, "\n"); \
+        failures++; \
+    } \
+} while (0)
+
+/**
+ * @brief Compare les moyennes des colonnes à celles de la promotion (flottants au bit près).
+ */
+static void checkSameAverages(const Prom* p, const PromColumns* cols, const char* label) {
+    for (int i = 0; i < p->num_students; i++) {
+        const Student* s = p->students[i];
+        CHECK(memcmp(&s->general_average, &cols->general_averages[i], sizeof(float)) == 0,
+              "%s : moyenne générale de %d différente (%.9g au lieu de %.9g)",
+              label, s->student_id, cols->general_averages[i], s->general_average);
+        for (int j = 0; j < s->num_courses; j++) {
+            const Enrollment* e = &s->courses[j];
+            size_t cell = (size_t)e->course_index * cols->num_students + i;
+            if (e->grades.size > 0)
+                CHECK(memcmp(&e->average, &cols->course_averages[cell], sizeof(float)) == 0,
+                      "%s : moyenne du cours %d de %d différente", label, e->course_index, s->student_id);
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage : %s <dossier_temporaire>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Prom* p = loadPromotionFromFile("data.txt");
+    CHECK(p != NULL && p->num_students > 0 && p->num_courses > 0, "lecture de data.txt impossible");
+    if (p == NULL)
+        return EXIT_FAILURE;
+
+    PromColumns* cols = createPromColumns(p);
+    CHECK(cols != NULL, "construction des colonnes impossible");
+    if (cols == NULL) {
+        destroyProm(p);
+        return EXIT_FAILURE;
+    }
+
+    CHECK(refreshColumnsAverages(cols) == 0, "recalcul des colonnes impossible");
+    checkSameAverages(p, cols, "recalcul");
+
+    int course = p->num_courses / 2;
+    CHECK(setCourseCoeff(p, course, 3.7f) == 0 && setCourseCoeffColumns(cols, course, 3.7f) == 0,
+          "changement du coefficient du cours %d impossible", course);
+    checkSameAverages(p, cols, "coefficient");
+
+    destroyPromColumns(cols);
+    destroyProm(p);
+
+    if (failures > 0) {
+        fprintf(stderr, "test_columns : %d échec(s)\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("test_columns : OK\n");
+    return EXIT_SUCCESS;
+}
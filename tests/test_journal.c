@@ -0,0 +1,224 @@
+/**
+ * @file test_journal.c
+ * @brief Journal des modifications : reprise après une écriture interrompue, refus d’un journal
+ *        corrompu, entrées refusées, classements tenus à jour.
+ *
+ * Usage : `test_journal <dossier_temporaire>`, lancé depuis la racine du dépôt (`make test`).
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "../struct.h"
+#include "../struct_functions.h"
+#include "../file_gestion.h"
+#include "../snapshot.h"
+#include "../journal.h"
+#include "../file_sorting.h"
+#include "../leaderboard.h"
+
+static int failures = 0;
+
+/** @brief Signale un échec si la condition est fausse. */
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "ÉCHEC %s:%d : ", __FILE__, __LINE__); \
+        fprintf(stderr, __VA_ARGS__); \
+        fprintf(stderr, "\n"); \
+        failures++; \
+    } \
+} while (0)
+
+static char snap_file[1024];
+static char journal_file[1024];
+
+/**
+ * @brief Taille d’un fichier, ou -1.
+ */
+static long fileSize(const char* filename) {
+    FILE* f = fopen(filename, "rb");
+    if (f == NULL)
+        return -1;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fclose(f);
+    return size;
+}
+
+/**
+ * @brief Écrit un snapshot neuf de la promotion et supprime le journal.
+ */
+static void resetFiles(const Prom* p) {
+    CHECK(saveSnapshot(snap_file, p) == 0, "écriture de %s impossible", snap_file);
+    remove(journal_file);
+}
+
+/**
+ * @brief Journalise `count` notes pour un étudiant, dans un journal rouvert pour l’occasion.
+ */
+static void journalGrades(Prom* p, int student_id, const char* course, int count) {
+    Journal* j = openJournal(snap_file, journal_file);
+    CHECK(j != NULL, "ouverture de %s impossible", journal_file);
+    if (j == NULL)
+        return;
+    for (int n = 0; n < count; n++)
+        CHECK(journalAddGrade(j, p, student_id, course, 10.0f + n) == 0, "note %d non journalisée", n);
+    closeJournal(j);
+}
+
+/**
+ * @brief Une fin de journal tronquée est supprimée à la réouverture : les entrées suivantes sont rejouées.
+ */
+static void testTornTail(Prom* p) {
+    resetFiles(p);
+    const Student* s = p->students[0];
+    const char* course = p->courses[s->courses[0].course_index].course_name;
+
+    journalGrades(p, s->student_id, course, 3);
+    long size = fileSize(journal_file);
+    CHECK(size > 3 && truncate(journal_file, size - 3) == 0, "troncature de %s impossible", journal_file);
+    journalGrades(p, s->student_id, course, 5);
+
+    Snapshot* snap = openSnapshot(snap_file);
+    Prom* restored = (snap != NULL) ? loadPromotionFromSnapshot(snap, LOAD_DEFAULT) : NULL;
+    closeSnapshot(snap);
+    CHECK(restored != NULL, "relecture de %s impossible", snap_file);
+    if (restored == NULL)
+        return;
+    int applied = replayJournal(journal_file, 0, restored);
+    CHECK(applied == 7, "%d entrées rejouées au lieu de 7", applied);
+    destroyProm(restored);
+}
+
+/**
+ * @brief Inverse les bits d’un octet du fichier.
+ */
+static void flipByte(const char* filename, long offset) {
+    FILE* f = fopen(filename, "r+b");
+    if (f == NULL)
+        return;
+    fseek(f, offset, SEEK_SET);
+    int c = fgetc(f);
+    fseek(f, offset, SEEK_SET);
+    fputc(~c & 0xFF, f);
+    fclose(f);
+}
+
+/**
+ * @brief Une dernière entrée altérée est coupée ; une entrée altérée au milieu fait refuser le journal, intact.
+ */
+static void testCorruptEntries(Prom* p) {
+    resetFiles(p);
+    const Student* s = p->students[0];
+    const char* course = p->courses[s->courses[0].course_index].course_name;
+
+    // Dernier octet de la dernière entrée : écriture interrompue, entrée coupée
+    journalGrades(p, s->student_id, course, 3);
+    long size = fileSize(journal_file);
+    flipByte(journal_file, size - 1);
+    journalGrades(p, s->student_id, course, 1);
+    CHECK(fileSize(journal_file) == size, "dernière entrée altérée non remplacée");
+
+    // Dernier octet de la première entrée : corruption, journal refusé et inchangé
+    long entry_size = (size - JOURNAL_HEADER_SIZE) / 3;
+    flipByte(journal_file, JOURNAL_HEADER_SIZE + entry_size - 1);
+    Journal* j = openJournal(snap_file, journal_file);
+    CHECK(j == NULL, "journal corrompu au milieu ouvert");
+    closeJournal(j);
+    CHECK(fileSize(journal_file) == size, "journal corrompu au milieu modifié");
+}
+
+/**
+ * @brief Une modification refusée n’écrit rien dans le journal et ne change pas la promotion.
+ */
+static void testRejectedEntries(Prom* p) {
+    resetFiles(p);
+    const Student* s = p->students[0];
+    const char* course = p->courses[s->courses[0].course_index].course_name;
+    int num_students = p->num_students;
+    int num_grades = s->courses[0].grades.size;
+
+    Journal* j = openJournal(snap_file, journal_file);
+    CHECK(j != NULL, "ouverture de %s impossible", journal_file);
+    if (j == NULL)
+        return;
+    long size = fileSize(journal_file);
+    CHECK(journalAddGrade(j, p, -1, course, 12.0f) == -1, "note d’un étudiant inconnu acceptée");
+    CHECK(journalAddGrade(j, p, s->student_id, "Matière inconnue", 12.0f) == -1, "note d’une matière inconnue acceptée");
+    CHECK(journalAddGrade(j, p, s->student_id, course, 42.0f) == -1, "note hors barème acceptée");
+    CHECK(journalAddStudent(j, p, s->student_id, "Ada", "Lovelace", 20) == -1, "numéro d’étudiant en double accepté");
+    CHECK(journalSetCoeff(j, p, "", 2.0f) == -1, "matière sans nom acceptée");
+    closeJournal(j);
+
+    CHECK(fileSize(journal_file) == size, "entrées refusées écrites dans %s", journal_file);
+    CHECK(p->num_students == num_students && s->courses[0].grades.size == num_grades, "promotion modifiée");
+}
+
+/**
+ * @brief Les classements restent actifs et exacts après une suite de notes journalisées.
+ */
+static void testLeaderboards(Prom* p) {
+    resetFiles(p);
+    CHECK(enableLeaderboards(p) == 0, "classements impossibles à construire");
+
+    Journal* j = openJournal(snap_file, journal_file);
+    CHECK(j != NULL, "ouverture de %s impossible", journal_file);
+    if (j == NULL)
+        return;
+    unsigned int seed = 12345;
+    for (int n = 0; n < 500; n++) {
+        seed = seed * 1103515245u + 12345u;
+        const Student* s = p->students[(seed >> 8) % (unsigned int)p->num_students];
+        if (s->num_courses == 0)
+            continue;
+        const char* course = p->courses[s->courses[(seed >> 4) % (unsigned int)s->num_courses].course_index].course_name;
+        float grade = (float)((seed >> 16) % 201) / 10.0f;
+        CHECK(journalAddGrade(j, p, s->student_id, course, grade) == 0, "note %d non journalisée", n);
+    }
+    closeJournal(j);
+    CHECK(p->leaderboards != NULL, "classements désactivés par les notes journalisées");
+
+    // Même sélection qu’avec le tas, une fois les classements supprimés
+    enum { K = 20 };
+    Student* from_boards[K];
+    Student* from_heap[K];
+    int count_boards = 0, count_heap = 0;
+    getTopKStudents(p, K, from_boards, &count_boards);
+    disableLeaderboards(p);
+    getTopKStudents(p, K, from_heap, &count_heap);
+    CHECK(count_boards == count_heap && memcmp(from_boards, from_heap, (size_t)count_heap * sizeof(Student*)) == 0,
+          "classement général différent de la sélection par tas");
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage : %s <dossier_temporaire>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    snprintf(snap_file, sizeof(snap_file), "%s/journal.snap", argv[1]);
+    snprintf(journal_file, sizeof(journal_file), "%s/journal.log", argv[1]);
+
+    Prom* p = loadPromotionFromFile("data.txt");
+    CHECK(p != NULL && p->num_students > 0, "lecture de data.txt impossible");
+    if (p == NULL)
+        return EXIT_FAILURE;
+
+    testTornTail(p);
+    testCorruptEntries(p);
+    testRejectedEntries(p);
+    testLeaderboards(p);
+
+    destroyProm(p);
+    remove(snap_file);
+    remove(journal_file);
+
+    if (failures > 0) {
+        fprintf(stderr, "test_journal : %d échec(s)\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("test_journal : OK\n");
+    return EXIT_SUCCESS;
+}
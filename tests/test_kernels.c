@@ -0,0 +1,112 @@
+/**
+ * @file test_kernels.c
+ * @brief Noyaux vectoriels : chaque version donne exactement les résultats de la version scalaire.
+ *
+ * Des cases de longueurs irrégulières (vides, plus courtes, égales ou plus longues
+ * qu’un vecteur, la dernière finissant au bout des notes) sont sommées puis moyennées
+ * avec chaque version proposée par le processeur ; sommes et moyennes doivent être
+ * celles de la version scalaire, au bit près.
+ *
+ * Usage : `test_kernels <dossier_temporaire>`, lancé depuis la racine du dépôt (`make test`).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../grade_kernels.h"
+
+/** @brief Nombre de cases. */
+#define NUM_CELLS 5000
+
+static int failures = 0;
+
+/** @brief Signale un échec si la condition est fausse. */
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "ÉCHEC %s:%d : ", __FILE__, __LINE__); \
+        fprintf(stderr, __VA_ARGS__); \
+        fprintf(stderr, "\n"); \
+        failures++; \
+    } \
+} while (0)
+
+/**
+ * @brief Longueur de la case `i` : toutes les longueurs autour de 16 et 32, parfois une longue case.
+ */
+static int cellLength(int i) {
+    if (i % 97 == 0)
+        return 200 + i % 300;
+    return (i * 7) % 70;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage : %s <dossier_temporaire>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int* offsets = malloc((NUM_CELLS + 1) * sizeof(int));
+    if (offsets == NULL)
+        return EXIT_FAILURE;
+    offsets[0] = 0;
+    for (int i = 0; i < NUM_CELLS; i++)
+        offsets[i + 1] = offsets[i] + cellLength(i);
+
+    // Notes allouées au plus juste : une lecture au-delà de offsets[n] serait hors du tableau
+    uint8_t* grades = malloc((size_t)offsets[NUM_CELLS]);
+    int* ref_sums = malloc(NUM_CELLS * sizeof(int));
+    int* sums = malloc(NUM_CELLS * sizeof(int));
+    float* ref_averages = malloc(NUM_CELLS * sizeof(float));
+    float* averages = malloc(NUM_CELLS * sizeof(float));
+    if (grades == NULL || ref_sums == NULL || sums == NULL || ref_averages == NULL || averages == NULL)
+        return EXIT_FAILURE;
+    unsigned seed = 12345;
+    for (int k = 0; k < offsets[NUM_CELLS]; k++) {
+        seed = seed * 1103515245u + 12345u;
+        grades[k] = (uint8_t)((seed >> 16) % 201);
+    }
+
+    CHECK(selectGradeKernels("scalar") == 0, "version scalaire indisponible");
+    sumGradeSegments(grades, offsets, ref_sums, NUM_CELLS);
+    averagesFromSums(ref_sums, offsets, ref_averages, NUM_CELLS);
+    for (int i = 0; i < NUM_CELLS; i++) {
+        int sum = 0;
+        for (int k = offsets[i]; k < offsets[i + 1]; k++)
+            sum += grades[k];
+        CHECK(ref_sums[i] == sum, "scalar : somme de la case %d fausse", i);
+    }
+
+    const char* versions[] = { "sse2", "avx2" };
+    for (int v = 0; v < 2; v++) {
+        if (selectGradeKernels(versions[v]) != 0) {
+            printf("test_kernels : version %s non prise en charge, ignorée\n", versions[v]);
+            continue;
+        }
+        // Toutes les cases, puis une suite qui ne commence pas au début des notes
+        sumGradeSegments(grades, offsets, sums, NUM_CELLS);
+        averagesFromSums(sums, offsets, averages, NUM_CELLS);
+        for (int i = 0; i < NUM_CELLS; i++) {
+            CHECK(sums[i] == ref_sums[i], "%s : somme de la case %d (%d notes) différente",
+                  versions[v], i, offsets[i + 1] - offsets[i]);
+            CHECK(memcmp(&averages[i], &ref_averages[i], sizeof(float)) == 0,
+                  "%s : moyenne de la case %d différente", versions[v], i);
+        }
+        sumGradeSegments(grades, offsets + 3, sums + 3, NUM_CELLS - 3);
+        for (int i = 3; i < NUM_CELLS; i++)
+            CHECK(sums[i] == ref_sums[i], "%s : somme de la case %d différente (suite décalée)", versions[v], i);
+    }
+
+    free(offsets);
+    free(grades);
+    free(ref_sums);
+    free(sums);
+    free(ref_averages);
+    free(averages);
+
+    if (failures > 0) {
+        fprintf(stderr, "test_kernels : %d échec(s)\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("test_kernels : OK\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file test_parallel.c
+ * @brief Chargement parallèle de la section NOTES : même promotion que le chargement séquentiel.
+ *
+ * `data.txt` est chargé séquentiellement, puis avec `LOAD_PARALLEL` sur 1 à 8 threads :
+ * inscriptions (et leur ordre), notes (et leur ordre) et moyennes doivent être identiques.
+ *
+ * Usage : `test_parallel <dossier_temporaire>`, lancé depuis la racine du dépôt (`make test`).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../struct.h"
+#include "../struct_functions.h"
+#include "../file_gestion.h"
+
+/** @brief Fichier chargé, à la racine du dépôt. */
+#define DATA_FILE "data.txt"
+
+static int failures = 0;
+
+/** @brief Signale un échec si la condition est fausse. */
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "ÉCHEC %s:%d : ", __FILE__, __LINE__); \
+        fprintf(stderr, __VA_ARGS__); \
+        fprintf(stderr, "\n"); \
+        failures++; \
+    } \
+} while (0)
+
+/**
+ * @brief Compare deux promotions chargées du même fichier (flottants au bit près).
+ */
+static void checkSameProm(const Prom* a, const Prom* b, int threads) {
+    CHECK(a->num_students == b->num_students && a->num_courses == b->num_courses,
+          "%d threads : %d étudiants, %d matières au lieu de %d, %d",
+          threads, b->num_students, b->num_courses, a->num_students, a->num_courses);
+    if (a->num_students != b->num_students)
+        return;
+
+    for (int i = 0; i < a->num_students; i++) {
+        const Student* x = a->students[i];
+        const Student* y = b->students[i];
+        CHECK(x->student_id == y->student_id && memcmp(&x->general_average, &y->general_average, sizeof(float)) == 0,
+              "%d threads : étudiant %d différent", threads, x->student_id);
+        CHECK(x->num_courses == y->num_courses, "%d threads : inscriptions de %d différentes", threads, x->student_id);
+        if (x->num_courses != y->num_courses)
+            continue;
+
+        for (int j = 0; j < x->num_courses; j++) {
+            const Enrollment* e = &x->courses[j];
+            const Enrollment* f = &y->courses[j];
+            CHECK(e->course_index == f->course_index && memcmp(&e->average, &f->average, sizeof(float)) == 0
+                  && e->grades.size == f->grades.size
+                  && memcmp(e->grades.grades_array, f->grades.grades_array, (size_t)e->grades.size) == 0,
+                  "%d threads : inscription %d de %d différente", threads, j, x->student_id);
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage : %s <dossier_temporaire>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Prom* ref = loadPromotionFromFile(DATA_FILE);
+    CHECK(ref != NULL && ref->num_students > 0, "lecture de %s impossible", DATA_FILE);
+    if (ref == NULL)
+        return EXIT_FAILURE;
+
+    for (int threads = 1; threads <= 8; threads++) {
+        Prom* p = loadPromotionFromFileParallel(DATA_FILE, LOAD_MMAP | LOAD_PARALLEL, threads);
+        CHECK(p != NULL, "chargement parallèle sur %d threads impossible", threads);
+        if (p != NULL)
+            checkSameProm(ref, p, threads);
+        destroyProm(p);
+    }
+    destroyProm(ref);
+
+    if (failures > 0) {
+        fprintf(stderr, "test_parallel : %d échec(s)\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("test_parallel : OK\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file test_snapshot.c
+ * @brief Lecture d’un seul étudiant d’un snapshot : résultat attendu, et refus d’un snapshot corrompu.
+ *
+ * Un snapshot de `data.txt` est écrit, puis un octet de chaque plage lue par
+ * `loadStudentFromBinaryFile()` pour l’étudiant cherché (enregistrement, inscriptions,
+ * notes, prénom) est altéré à tour de rôle : la lecture doit alors échouer. Un octet
+ * altéré dans un bloc que la lecture ne touche pas ne l’empêche pas, mais
+ * `verifySnapshot()` le détecte.
+ *
+ * Usage : `test_snapshot <dossier_temporaire>`, lancé depuis la racine du dépôt (`make test`).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../struct.h"
+#include "../struct_functions.h"
+#include "../file_gestion.h"
+#include "../snapshot.h"
+
+static int failures = 0;
+
+/** @brief Signale un échec si la condition est fausse. */
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "ÉCHEC %s:%d : ", __FILE__, __LINE__); \
+        fprintf(stderr, __VA_ARGS__); \
+        fprintf(stderr, "\n"); \
+        failures++; \
+    } \
+} while (0)
+
+/**
+ * @brief Inverse les bits d’un octet du fichier.
+ */
+static void flipByte(const char* filename, long offset) {
+    FILE* f = fopen(filename, "r+b");
+    if (f == NULL)
+        return;
+    fseek(f, offset, SEEK_SET);
+    int c = fgetc(f);
+    fseek(f, offset, SEEK_SET);
+    fputc(~c & 0xFF, f);
+    fclose(f);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage : %s <dossier_temporaire>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    char snap_file[1024];
+    snprintf(snap_file, sizeof(snap_file), "%s/lookup.snap", argv[1]);
+
+    Prom* p = loadPromotionFromFile("data.txt");
+    CHECK(p != NULL && p->num_students > 0, "lecture de data.txt impossible");
+    if (p == NULL)
+        return EXIT_FAILURE;
+    CHECK(saveSnapshot(snap_file, p) == 0, "écriture de %s impossible", snap_file);
+
+    // Étudiant du milieu de la promotion : mêmes notes qu’en mémoire
+    const Student* ref = p->students[p->num_students / 2];
+    Prom* one = loadStudentFromBinaryFile(snap_file, ref->student_id);
+    CHECK(one != NULL && one->num_students == 1, "étudiant %d introuvable", ref->student_id);
+    if (one != NULL && one->num_students == 1) {
+        const Student* s = one->students[0];
+        CHECK(strcmp(s->first_name, ref->first_name) == 0 && s->num_courses == ref->num_courses,
+              "étudiant %d différent", ref->student_id);
+        for (int j = 0; j < s->num_courses && j < ref->num_courses; j++)
+            CHECK(s->courses[j].grades.size == ref->courses[j].grades.size
+                  && memcmp(s->courses[j].grades.grades_array, ref->courses[j].grades.grades_array,
+                            (size_t)s->courses[j].grades.size) == 0,
+                  "notes du cours %d différentes", j);
+    }
+    destroyProm(one);
+
+    // Position d’un octet dans chaque plage lue pour cet étudiant, et d’une note hors de ses blocs
+    Snapshot* snap = openSnapshot(snap_file);
+    CHECK(snap != NULL, "ouverture de %s impossible", snap_file);
+    const SnapshotStudent* rec = findSnapshotStudent(snap, ref->student_id);
+    CHECK(rec != NULL && rec->num_enrollments > 0, "étudiant %d absent du snapshot", ref->student_id);
+    if (snap == NULL || rec == NULL || rec->num_enrollments == 0) {
+        closeSnapshot(snap);
+        destroyProm(p);
+        return EXIT_FAILURE;
+    }
+    const unsigned char* base = snap->map;
+    const SnapshotEnrollment* last = &snap->enrollments[rec->first_enrollment + rec->num_enrollments - 1];
+    long offsets[] = {
+        (long)((const unsigned char*)&rec->age - base),
+        (long)((const unsigned char*)&last->average - base),
+        (long)(snap->grades + last->first_grade + last->num_grades - 1 - base),
+        (long)((const unsigned char*)snap->strings + rec->first_name - base),
+    };
+    const char* names[] = { "étudiant", "inscription", "note", "prénom" };
+    long unrelated = (long)(snap->grades + snap->num_grades - 1 - base);
+    int far_block = (snap->num_grades - 1) / SNAPSHOT_CRC_BLOCK != (last->first_grade + last->num_grades) / SNAPSHOT_CRC_BLOCK;
+    closeSnapshot(snap);
+
+    for (int k = 0; k < 4; k++) {
+        CHECK(saveSnapshot(snap_file, p) == 0, "écriture de %s impossible", snap_file);
+        flipByte(snap_file, offsets[k]);
+        one = loadStudentFromBinaryFile(snap_file, ref->student_id);
+        CHECK(one == NULL, "%s corrompu accepté", names[k]);
+        destroyProm(one);
+    }
+
+    // Corruption hors des blocs lus : lecture acceptée, vérification complète refusée
+    CHECK(far_block, "notes de l’étudiant %d dans le dernier bloc", ref->student_id);
+    CHECK(saveSnapshot(snap_file, p) == 0, "écriture de %s impossible", snap_file);
+    flipByte(snap_file, unrelated);
+    one = loadStudentFromBinaryFile(snap_file, ref->student_id);
+    CHECK(one != NULL, "étudiant %d refusé pour un bloc qu’il ne lit pas", ref->student_id);
+    destroyProm(one);
+    snap = openSnapshot(snap_file);
+    CHECK(snap != NULL && verifySnapshot(snap) == -1, "note corrompue non détectée par verifySnapshot");
+    closeSnapshot(snap);
+
+    destroyProm(p);
+    remove(snap_file);
+
+    if (failures > 0) {
+        fprintf(stderr, "test_snapshot : %d échec(s)\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("test_snapshot : OK\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,201 @@
+/**
+ * @file tokenizer.c
+ * @brief Implémentation du découpage sans copie des lignes du fichier de données.
+ *
+ * Remplace les appels à `sscanf()` des fonctions d’analyse : aucun tampon
+ * intermédiaire, conversion directe des entiers et des décimaux courts.
+ *
+ * @see tokenizer.h
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "./tokenizer.h"
+
+/** @brief Nombre maximal de chiffres significatifs convertis sans `strtof()`. */
+#define FAST_DECIMAL_DIGITS 7
+
+/** @brief Nombre maximal de décimales converties sans `strtof()`. */
+#define FAST_DECIMAL_FRACTION 4
+
+/**
+ * @brief Puissances de 10 exactes en double, pour la conversion rapide des décimaux.
+ */
+static const double POW10[FAST_DECIMAL_FRACTION + 1] = { 1.0, 10.0, 100.0, 1000.0, 10000.0 };
+
+/**
+ * @brief Prépare le découpage d’une ligne.
+ */
+void initTokenizer(LineTokenizer* t, const char* line, size_t length, int line_no) {
+    while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r'))
+        length--;
+
+    t->line = line;
+    t->cur = line;
+    t->end = line + length;
+    t->line_no = line_no;
+    t->error_column = 0;
+    t->error = NULL;
+}
+
+/**
+ * @brief Indique si la ligne est vide.
+ */
+int isBlankLine(const LineTokenizer* t) {
+    for (const char* p = t->line; p < t->end; p++) {
+        if (*p != ' ' && *p != '\t')
+            return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Mémorise une erreur portant sur un champ.
+ */
+int setTokenError(LineTokenizer* t, const Field* field, const char* message) {
+    const char* where = field != NULL ? field->start : (t->cur != NULL ? t->cur : t->end);
+    t->error_column = (int)(where - t->line) + 1;
+    t->error = message;
+    return -1;
+}
+
+/**
+ * @brief Lit le champ suivant jusqu’au prochain `;`.
+ */
+int nextField(LineTokenizer* t, Field* field) {
+    if (t->cur == NULL)
+        return setTokenError(t, NULL, "champ manquant");
+
+    const char* start = t->cur;
+    const char* sep = memchr(start, ';', (size_t)(t->end - start));
+    if (sep == NULL)
+        sep = t->end;
+
+    field->start = start;
+    field->length = (int)(sep - start);
+
+    // On se place après le séparateur ; NULL marque la fin de la ligne
+    t->cur = (sep < t->end) ? sep + 1 : NULL;
+
+    if (field->length == 0)
+        return setTokenError(t, field, "champ vide");
+    return 0;
+}
+
+/**
+ * @brief Ignore les espaces en début et fin de champ.
+ */
+static void trimField(Field* field) {
+    while (field->length > 0 && (field->start[0] == ' ' || field->start[0] == '\t')) {
+        field->start++;
+        field->length--;
+    }
+    while (field->length > 0 && (field->start[field->length - 1] == ' ' || field->start[field->length - 1] == '\t'))
+        field->length--;
+}
+
+/**
+ * @brief Lit le champ suivant et le convertit en entier.
+ */
+int nextIntField(LineTokenizer* t, int* value) {
+    Field f;
+    if (nextField(t, &f) == -1)
+        return -1;
+    trimField(&f);
+
+    const char* p = f.start;
+    const char* end = f.start + f.length;
+    int negative = 0;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        p++;
+    }
+    if (p == end)
+        return setTokenError(t, &f, "entier attendu");
+
+    long long n = 0;
+    for (; p < end; p++) {
+        if (*p < '0' || *p > '9')
+            return setTokenError(t, &f, "entier attendu");
+        n = n * 10 + (*p - '0');
+        if (n > 2147483648LL)
+            return setTokenError(t, &f, "entier trop grand");
+    }
+    if (negative)
+        n = -n;
+    if (n > 2147483647LL)
+        return setTokenError(t, &f, "entier trop grand");
+
+    *value = (int)n;
+    return 0;
+}
+
+/**
+ * @brief Lit le champ suivant et le convertit en nombre décimal.
+ */
+int nextDecimalField(LineTokenizer* t, float* value) {
+    Field f;
+    if (nextField(t, &f) == -1)
+        return -1;
+    trimField(&f);
+    if (f.length == 0)
+        return setTokenError(t, &f, "nombre attendu");
+
+    const char* p = f.start;
+    const char* end = f.start + f.length;
+    int negative = 0;
+    if (*p == '-' || *p == '+') {
+        negative = (*p == '-');
+        p++;
+    }
+
+    // Chemin rapide : chiffres[.chiffres], mantisse entière exacte divisée par 10^k
+    long mantissa = 0;
+    int digits = 0, fraction = -1, fast = 1;
+    for (; p < end && fast; p++) {
+        if (*p >= '0' && *p <= '9') {
+            mantissa = mantissa * 10 + (*p - '0');
+            digits++;
+            if (fraction >= 0)
+                fraction++;
+        }
+        else if (*p == '.' && fraction < 0) {
+            fraction = 0;
+        }
+        else {
+            fast = 0;
+        }
+    }
+    if (fraction < 0)
+        fraction = 0;
+
+    if (fast && digits > 0 && digits <= FAST_DECIMAL_DIGITS && fraction <= FAST_DECIMAL_FRACTION) {
+        float v = (float)((double)mantissa / POW10[fraction]);
+        *value = negative ? -v : v;
+        return 0;
+    }
+
+    // Écriture inhabituelle : conversion standard sur une copie bornée
+    char buffer[64];
+    if (f.length >= (int)sizeof(buffer))
+        return setTokenError(t, &f, "nombre trop long");
+    memcpy(buffer, f.start, f.length);
+    buffer[f.length] = '\0';
+
+    char* stop;
+    float v = strtof(buffer, &stop);
+    if (stop == buffer || *stop != '\0')
+        return setTokenError(t, &f, "nombre attendu");
+
+    *value = v;
+    return 0;
+}
+
+/**
+ * @brief Affiche la dernière erreur du tokenizer avec sa ligne et sa colonne.
+ */
+void reportTokenError(const LineTokenizer* t, const char* context) {
+    fprintf(stderr, "⚠️ Erreur ligne %d, colonne %d (%s) : %s.\n",
+            t->line_no, t->error_column, context, t->error != NULL ? t->error : "ligne invalide");
+}
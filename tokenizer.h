@@ -0,0 +1,114 @@
+/**
+ * @file tokenizer.h
+ * @brief Découpage sans copie des lignes `champ;champ;...` du fichier de données.
+ *
+ * Le tokenizer parcourt une ligne en place : chaque champ est rendu sous forme
+ * de tranche (`Field`, pointeur + longueur) pointant dans le tampon d’origine,
+ * sans copie ni terminaison par `'\0'`. Les entiers et les notes décimales sont
+ * convertis directement depuis la tranche.
+ *
+ * En cas d’erreur, le tokenizer mémorise la colonne fautive et un message,
+ * affichables avec `reportTokenError()`.
+ *
+ * @see file_gestion.h
+ */
+
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <stddef.h>
+
+/**
+ * @struct Field
+ * @brief Tranche d’une ligne correspondant à un champ (non terminée par `'\0'`).
+ */
+typedef struct Field {
+    const char* start;      /**< Premier caractère du champ. */
+    int length;             /**< Nombre de caractères du champ. */
+} Field;
+
+/**
+ * @struct LineTokenizer
+ * @brief État du découpage d’une ligne.
+ */
+typedef struct LineTokenizer {
+    const char* line;       /**< Début de la ligne (pour le calcul des colonnes). */
+    const char* cur;        /**< Position courante dans la ligne, NULL une fois le dernier champ lu. */
+    const char* end;        /**< Fin de la ligne, sans `'\n'` ni `'\r'` final. */
+    int line_no;            /**< Numéro de la ligne dans le fichier (0 si inconnu). */
+    int error_column;       /**< Colonne (à partir de 1) de la dernière erreur, 0 si aucune. */
+    const char* error;      /**< Message de la dernière erreur, NULL si aucune. */
+} LineTokenizer;
+
+/**
+ * @brief Prépare le découpage d’une ligne.
+ *
+ * Les caractères `'\n'` et `'\r'` de fin de ligne sont ignorés.
+ *
+ * @param t       Tokenizer à initialiser.
+ * @param line    Début de la ligne.
+ * @param length  Longueur de la ligne en octets.
+ * @param line_no Numéro de la ligne (utilisé dans les messages d’erreur).
+ */
+void initTokenizer(LineTokenizer* t, const char* line, size_t length, int line_no);
+
+/**
+ * @brief Indique si la ligne est vide (ou ne contient que des espaces).
+ *
+ * @param t Tokenizer initialisé.
+ * @return 1 si la ligne est vide, 0 sinon.
+ */
+int isBlankLine(const LineTokenizer* t);
+
+/**
+ * @brief Lit le champ suivant, jusqu’au prochain `;` ou à la fin de la ligne.
+ *
+ * @param t     Tokenizer.
+ * @param field Tranche renseignée avec le champ lu.
+ * @return 0 si un champ non vide a été lu, -1 sinon (erreur mémorisée).
+ */
+int nextField(LineTokenizer* t, Field* field);
+
+/**
+ * @brief Lit le champ suivant et le convertit en entier.
+ *
+ * Les espaces autour du nombre et un signe sont acceptés, comme avec `%d`.
+ *
+ * @param t     Tokenizer.
+ * @param value Entier lu.
+ * @return 0 si succès, -1 si le champ n’est pas un entier valide (erreur mémorisée).
+ */
+int nextIntField(LineTokenizer* t, int* value);
+
+/**
+ * @brief Lit le champ suivant et le convertit en nombre décimal (note, coefficient).
+ *
+ * Les nombres courts (`12`, `12.5`, `2.25`) sont convertis sans passer par la
+ * bibliothèque standard, avec un résultat identique à `strtof()` ; les autres
+ * écritures (exposant, nombreux chiffres) sont confiées à `strtof()`.
+ *
+ * @param t     Tokenizer.
+ * @param value Valeur lue.
+ * @return 0 si succès, -1 si le champ n’est pas un nombre valide (erreur mémorisée).
+ */
+int nextDecimalField(LineTokenizer* t, float* value);
+
+/**
+ * @brief Mémorise une erreur portant sur un champ déjà lu.
+ *
+ * @param t       Tokenizer.
+ * @param field   Champ en cause (sa colonne est utilisée), ou NULL pour la position courante.
+ * @param message Message d’erreur (chaîne statique).
+ * @return Toujours -1, pour pouvoir écrire `return setTokenError(...)`.
+ */
+int setTokenError(LineTokenizer* t, const Field* field, const char* message);
+
+/**
+ * @brief Affiche la dernière erreur du tokenizer sur `stderr` avec sa ligne et sa colonne.
+ *
+ * @param t       Tokenizer.
+ * @param context Description de la section analysée (ex. "note").
+ */
+void reportTokenError(const LineTokenizer* t, const char* context);
+
+#endif // TOKENIZER_H